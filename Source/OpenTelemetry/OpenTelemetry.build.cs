@@ -15,6 +15,7 @@ public class OpenTelemetry : ModuleRules
 			"Analytics",
 			"Engine",
 			"CoreUObject",
+			"Projects",
 			"RenderCore",
 			"RHI",
 			"libotel",
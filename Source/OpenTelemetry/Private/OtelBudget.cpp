@@ -0,0 +1,429 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelBudget.h"
+#include "OtelOverhead.h"
+
+#include "opentelemetry/sdk/logs/batch_log_record_processor_factory.h"
+#include "opentelemetry/sdk/trace/batch_span_processor_factory.h"
+#include "opentelemetry/trace/span_context.h"
+#include "opentelemetry/trace/trace_state.h"
+
+// Pressure has to drop this far below the limits before rates start coming back, so they don't oscillate
+static constexpr double RestorePressure = 0.5;
+
+// Rates are cut by the pressure within these bounds, and restored in fixed steps
+static constexpr double MinDecreaseFactor = 0.5;
+static constexpr double MaxDecreaseFactor = 0.9;
+static constexpr double IncreaseStep = 0.05;
+
+// Cut rates only approach MinRate, so with a MinRate of 0 event rates would never get low enough for sampling to start
+static constexpr double MinRateFloor = 0.001;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Sampler and export pipeline wrappers
+
+class FOtelBudgetSampler : public otel::sdk::trace::Sampler
+{
+public:
+	FOtelBudgetSampler(TSharedRef<FOtelBudgetState> InState)
+		: State(InState)
+	{
+	}
+
+	virtual otel::sdk::trace::SamplingResult ShouldSample(
+		const otel::trace::SpanContext& ParentContext,
+		otel::trace::TraceId TraceId,
+		otel::nostd::string_view Name,
+		otel::trace::SpanKind SpanKind,
+		const otel::common::KeyValueIterable& Attributes,
+		const otel::trace::SpanContextKeyValueIterable& Links) noexcept override
+	{
+		using otel::sdk::trace::Decision;
+
+		// Keep traces whole by following the root's decision
+		if (ParentContext.IsValid())
+		{
+			return { ParentContext.IsSampled() ? Decision::RECORD_AND_SAMPLE : Decision::DROP, nullptr, ParentContext.trace_state() };
+		}
+
+		const double Rate = State->SamplingRate.load(std::memory_order_relaxed);
+		if (Rate < 1.0)
+		{
+			// Like TraceIdRatioBasedSampler, use the random part of the trace id so the decision is stable per trace
+			uint64 TraceIdValue = 0;
+			FMemory::Memcpy(&TraceIdValue, TraceId.Id().data() + TraceId.Id().size() - sizeof(TraceIdValue), sizeof(TraceIdValue));
+			if (static_cast<double>(TraceIdValue) >= Rate * static_cast<double>(MAX_uint64))
+			{
+				return { Decision::DROP, nullptr, otel::trace::TraceState::GetDefault() };
+			}
+		}
+
+		// Unthrottled traces don't need scaling, so they're spared the allocation
+		if (Rate >= 1.0)
+		{
+			return { Decision::RECORD_AND_SAMPLE, nullptr, otel::trace::TraceState::GetDefault() };
+		}
+
+		auto SamplingAttributes = std::make_unique<std::map<std::string, otel::common::AttributeValue>>();
+		SamplingAttributes->emplace("sampling_rate", Rate);
+		return { Decision::RECORD_AND_SAMPLE, MoveTemp(SamplingAttributes), otel::trace::TraceState::GetDefault() };
+	}
+
+	virtual otel::nostd::string_view GetDescription() const noexcept override
+	{
+		return "OtelBudgetSampler";
+	}
+
+private:
+	TSharedRef<FOtelBudgetState> State;
+};
+
+class FOtelBudgetSpanExporter : public otel::sdk::trace::SpanExporter
+{
+public:
+	FOtelBudgetSpanExporter(std::unique_ptr<otel::sdk::trace::SpanExporter> InInner, TSharedRef<FOtelBudgetState> InState)
+		: Inner(MoveTemp(InInner))
+		, State(InState)
+	{
+	}
+
+	virtual std::unique_ptr<otel::sdk::trace::Recordable> MakeRecordable() noexcept override
+	{
+		return Inner->MakeRecordable();
+	}
+
+	virtual otel::sdk::common::ExportResult Export(const otel::nostd::span<std::unique_ptr<otel::sdk::trace::Recordable>>& Spans) noexcept override
+	{
+		State->SpanQueue.OnExported(static_cast<int64>(Spans.size()));
+		return Inner->Export(Spans);
+	}
+
+	virtual bool ForceFlush(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->ForceFlush(Timeout);
+	}
+
+	virtual bool Shutdown(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->Shutdown(Timeout);
+	}
+
+private:
+	std::unique_ptr<otel::sdk::trace::SpanExporter> Inner;
+	TSharedRef<FOtelBudgetState> State;
+};
+
+class FOtelBudgetSpanProcessor : public otel::sdk::trace::SpanProcessor
+{
+public:
+	FOtelBudgetSpanProcessor(std::unique_ptr<otel::sdk::trace::SpanProcessor> InInner, TSharedRef<FOtelBudgetState> InState)
+		: Inner(MoveTemp(InInner))
+		, State(InState)
+	{
+	}
+
+	virtual std::unique_ptr<otel::sdk::trace::Recordable> MakeRecordable() noexcept override
+	{
+		return Inner->MakeRecordable();
+	}
+
+	virtual void OnStart(otel::sdk::trace::Recordable& Span, const otel::trace::SpanContext& ParentContext) noexcept override
+	{
+		Inner->OnStart(Span, ParentContext);
+	}
+
+	virtual void OnEnd(std::unique_ptr<otel::sdk::trace::Recordable>&& Span) noexcept override
+	{
+		State->SpanQueue.OnQueued();
+		Inner->OnEnd(MoveTemp(Span));
+	}
+
+	virtual bool ForceFlush(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->ForceFlush(Timeout);
+	}
+
+	virtual bool Shutdown(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->Shutdown(Timeout);
+	}
+
+private:
+	std::unique_ptr<otel::sdk::trace::SpanProcessor> Inner;
+	TSharedRef<FOtelBudgetState> State;
+};
+
+class FOtelBudgetLogExporter : public otel::sdk::logs::LogRecordExporter
+{
+public:
+	FOtelBudgetLogExporter(std::unique_ptr<otel::sdk::logs::LogRecordExporter> InInner, TSharedRef<FOtelBudgetState> InState)
+		: Inner(MoveTemp(InInner))
+		, State(InState)
+	{
+	}
+
+	virtual std::unique_ptr<otel::sdk::logs::Recordable> MakeRecordable() noexcept override
+	{
+		return Inner->MakeRecordable();
+	}
+
+	virtual otel::sdk::common::ExportResult Export(const otel::nostd::span<std::unique_ptr<otel::sdk::logs::Recordable>>& Records) noexcept override
+	{
+		State->LogQueue.OnExported(static_cast<int64>(Records.size()));
+		return Inner->Export(Records);
+	}
+
+	virtual bool ForceFlush(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->ForceFlush(Timeout);
+	}
+
+	virtual bool Shutdown(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->Shutdown(Timeout);
+	}
+
+private:
+	std::unique_ptr<otel::sdk::logs::LogRecordExporter> Inner;
+	TSharedRef<FOtelBudgetState> State;
+};
+
+class FOtelBudgetLogProcessor : public otel::sdk::logs::LogRecordProcessor
+{
+public:
+	FOtelBudgetLogProcessor(std::unique_ptr<otel::sdk::logs::LogRecordProcessor> InInner, TSharedRef<FOtelBudgetState> InState)
+		: Inner(MoveTemp(InInner))
+		, State(InState)
+	{
+	}
+
+	virtual std::unique_ptr<otel::sdk::logs::Recordable> MakeRecordable() noexcept override
+	{
+		return Inner->MakeRecordable();
+	}
+
+	virtual void OnEmit(std::unique_ptr<otel::sdk::logs::Recordable>&& Record) noexcept override
+	{
+		State->LogQueue.OnQueued();
+		Inner->OnEmit(MoveTemp(Record));
+	}
+
+	virtual bool ForceFlush(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->ForceFlush(Timeout);
+	}
+
+	virtual bool Shutdown(std::chrono::microseconds Timeout) noexcept override
+	{
+		return Inner->Shutdown(Timeout);
+	}
+
+private:
+	std::unique_ptr<otel::sdk::logs::LogRecordProcessor> Inner;
+	TSharedRef<FOtelBudgetState> State;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FOtelBudgetState
+
+void FOtelBudgetState::FQueue::OnQueued()
+{
+	// The batch processor drops records that arrive while its queue is full, so those never come out again
+	int64 Current = Pending.load(std::memory_order_relaxed);
+	while (Current < MaxQueueSize && Pending.compare_exchange_weak(Current, Current + 1, std::memory_order_relaxed) == false)
+	{
+	}
+}
+
+void FOtelBudgetState::FQueue::OnExported(int64 NumRecords)
+{
+	int64 Current = Pending.load(std::memory_order_relaxed);
+	while (Pending.compare_exchange_weak(Current, FMath::Max<int64>(Current - NumRecords, 0), std::memory_order_relaxed) == false)
+	{
+	}
+}
+
+double FOtelBudgetState::FQueue::GetFill() const
+{
+	if (MaxQueueSize <= 0)
+	{
+		return 0.0;
+	}
+	return FMath::Clamp(static_cast<double>(Pending.load(std::memory_order_relaxed)) / static_cast<double>(MaxQueueSize), 0.0, 1.0);
+}
+
+bool FOtelBudgetState::ShouldCaptureEvent()
+{
+	return ShouldKeep(EventCounter, EventRate.load(std::memory_order_relaxed));
+}
+
+bool FOtelBudgetState::ShouldRouteLog()
+{
+	return ShouldKeep(LogCounter, LogRate.load(std::memory_order_relaxed));
+}
+
+bool FOtelBudgetState::ShouldKeep(std::atomic<uint64>& Counter, double Rate)
+{
+	if (Rate >= 1.0)
+	{
+		return true;
+	}
+
+	const uint64 Index = Counter.fetch_add(1, std::memory_order_relaxed);
+	return FMath::FloorToDouble(static_cast<double>(Index + 1) * Rate) > FMath::FloorToDouble(static_cast<double>(Index) * Rate);
+}
+
+std::unique_ptr<otel::sdk::trace::Sampler> FOtelBudgetState::CreateSampler()
+{
+	return std::make_unique<FOtelBudgetSampler>(AsShared());
+}
+
+std::unique_ptr<otel::sdk::trace::SpanProcessor> FOtelBudgetState::CreateSpanProcessor(std::unique_ptr<otel::sdk::trace::SpanExporter> Exporter, const otel::sdk::trace::BatchSpanProcessorOptions& Options)
+{
+	SpanQueue.MaxQueueSize = static_cast<int64>(Options.max_queue_size);
+
+	auto BudgetExporter = std::make_unique<FOtelBudgetSpanExporter>(MoveTemp(Exporter), AsShared());
+	auto Processor = otel::sdk::trace::BatchSpanProcessorFactory::Create(MoveTemp(BudgetExporter), Options);
+	return std::make_unique<FOtelBudgetSpanProcessor>(MoveTemp(Processor), AsShared());
+}
+
+std::unique_ptr<otel::sdk::logs::LogRecordProcessor> FOtelBudgetState::CreateLogProcessor(std::unique_ptr<otel::sdk::logs::LogRecordExporter> Exporter, const otel::sdk::logs::BatchLogRecordProcessorOptions& Options)
+{
+	LogQueue.MaxQueueSize = static_cast<int64>(Options.max_queue_size);
+
+	auto BudgetExporter = std::make_unique<FOtelBudgetLogExporter>(MoveTemp(Exporter), AsShared());
+	auto Processor = otel::sdk::logs::BatchLogRecordProcessorFactory::Create(MoveTemp(BudgetExporter), Options);
+	return std::make_unique<FOtelBudgetLogProcessor>(MoveTemp(Processor), AsShared());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// FOtelBudget
+
+FOtelBudget::FOtelBudget(FOtelModule& InModule, TSharedRef<FOtelBudgetState> InState)
+	: Module(InModule)
+	, State(InState)
+{
+	const FOtelBudgetConfig& Config = Module.GetConfig().Budget;
+	FrameBudgetMs = Config.FrameBudgetMs;
+	MaxQueueFill = Config.MaxQueueFill;
+	MinRate = FMath::Clamp<double>(Config.MinRate, MinRateFloor, 1.0);
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("otel_budget"));
+
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("otel_budget_rate"), [this](FOtelObserver& Observer)
+		{
+			const FAnalyticsEventAttribute SamplingAttributes[] = { FAnalyticsEventAttribute(TEXT("kind"), TEXT("sampling")) };
+			const FAnalyticsEventAttribute EventAttributes[] = { FAnalyticsEventAttribute(TEXT("kind"), TEXT("events")) };
+			const FAnalyticsEventAttribute LogAttributes[] = { FAnalyticsEventAttribute(TEXT("kind"), TEXT("logs")) };
+			Observer.Observe(State->SamplingRate.load(std::memory_order_relaxed), SamplingAttributes);
+			Observer.Observe(State->EventRate.load(std::memory_order_relaxed), EventAttributes);
+			Observer.Observe(State->LogRate.load(std::memory_order_relaxed), LogAttributes);
+		}));
+
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("otel_budget_queue_fill"), [this](FOtelObserver& Observer)
+		{
+			const FAnalyticsEventAttribute SpanAttributes[] = { FAnalyticsEventAttribute(TEXT("signal"), TEXT("spans")) };
+			const FAnalyticsEventAttribute LogAttributes[] = { FAnalyticsEventAttribute(TEXT("signal"), TEXT("logs")) };
+			Observer.Observe(State->SpanQueue.GetFill(), SpanAttributes);
+			Observer.Observe(State->LogQueue.GetFill(), LogAttributes);
+		}));
+
+	Module.RegisterCollector(this);
+}
+
+FOtelBudget::~FOtelBudget()
+{
+	Module.UnregisterCollector(this);
+	Instruments.Reset();
+
+	// Nothing is left to restore the rates once the controller is gone
+	State->SamplingRate.store(1.0, std::memory_order_relaxed);
+	State->EventRate.store(1.0, std::memory_order_relaxed);
+	State->LogRate.store(1.0, std::memory_order_relaxed);
+}
+
+FName FOtelBudget::GetName() const
+{
+	return TEXT("Budget");
+}
+
+FOtelCollectorSettings FOtelBudget::GetDefaultSettings() const
+{
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 0.25;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
+
+void FOtelBudget::Collect(double DeltaSeconds)
+{
+	double OverheadPressure = 0.0;
+	const uint64 FrameCounter = GFrameCounter;
+	// Only game thread overhead holds up the frame. Exporter and worker threads can be slow without costing the game.
+	const uint64 TotalCycles = FOtelOverheadTotals::Gather().GameThreadCycles;
+	if (FrameBudgetMs > 0.0 && LastFrameCounter != 0 && FrameCounter > LastFrameCounter)
+	{
+		const double OverheadMs = FPlatformTime::ToMilliseconds64(TotalCycles - LastTotalCycles) / static_cast<double>(FrameCounter - LastFrameCounter);
+		OverheadPressure = OverheadMs / FrameBudgetMs;
+	}
+	LastFrameCounter = FrameCounter;
+	LastTotalCycles = TotalCycles;
+
+	double SpanPressure = OverheadPressure;
+	double LogPressure = OverheadPressure;
+	if (MaxQueueFill > 0.0)
+	{
+		SpanPressure = FMath::Max(SpanPressure, State->SpanQueue.GetFill() / MaxQueueFill);
+		LogPressure = FMath::Max(LogPressure, State->LogQueue.GetFill() / MaxQueueFill);
+	}
+
+	// Events are cheaper to lose than whole traces, so they go first and come back last
+	double SamplingRate = State->SamplingRate.load(std::memory_order_relaxed);
+	double EventRate = State->EventRate.load(std::memory_order_relaxed);
+	if (SpanPressure > 1.0)
+	{
+		if (EventRate > MinRate)
+		{
+			EventRate = Decrease(EventRate, SpanPressure);
+		}
+		else
+		{
+			SamplingRate = Decrease(SamplingRate, SpanPressure);
+		}
+	}
+	else if (SpanPressure < RestorePressure)
+	{
+		if (SamplingRate < 1.0)
+		{
+			SamplingRate = Increase(SamplingRate);
+		}
+		else
+		{
+			EventRate = Increase(EventRate);
+		}
+	}
+	State->SamplingRate.store(SamplingRate, std::memory_order_relaxed);
+	State->EventRate.store(EventRate, std::memory_order_relaxed);
+
+	double LogRate = State->LogRate.load(std::memory_order_relaxed);
+	if (LogPressure > 1.0)
+	{
+		LogRate = Decrease(LogRate, LogPressure);
+	}
+	else if (LogPressure < RestorePressure)
+	{
+		LogRate = Increase(LogRate);
+	}
+	State->LogRate.store(LogRate, std::memory_order_relaxed);
+}
+
+double FOtelBudget::Decrease(double Rate, double Pressure) const
+{
+	const double Factor = FMath::Clamp(1.0 / Pressure, MinDecreaseFactor, MaxDecreaseFactor);
+	return FMath::Max(MinRate, Rate * Factor);
+}
+
+double FOtelBudget::Increase(double Rate) const
+{
+	return FMath::Min(1.0, Rate + IncreaseStep);
+}
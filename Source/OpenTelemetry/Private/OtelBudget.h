@@ -0,0 +1,94 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+#include "opentelemetry/sdk/logs/batch_log_record_processor_options.h"
+#include "opentelemetry/sdk/logs/exporter.h"
+#include "opentelemetry/sdk/logs/processor.h"
+#include "opentelemetry/sdk/trace/batch_span_processor_options.h"
+#include "opentelemetry/sdk/trace/exporter.h"
+#include "opentelemetry/sdk/trace/processor.h"
+#include "opentelemetry/sdk/trace/sampler.h"
+
+#include <atomic>
+
+// The rates the budget controller sets, and the queue fill levels it reads. Shared with the sampler and the export
+// pipelines, which live in the tracer and logger providers and can outlive the controller.
+class FOtelBudgetState : public TSharedFromThis<FOtelBudgetState>
+{
+public:
+	// Estimates how many records are waiting in a batch processor's queue. The processor doesn't expose its queue, so
+	// this counts records going in and out. Records queued while it's full are dropped by the processor, so they're
+	// not counted.
+	struct FQueue
+	{
+		std::atomic<int64> Pending = 0;
+		int64 MaxQueueSize = 0;
+
+		void OnQueued();
+		void OnExported(int64 NumRecords);
+		double GetFill() const;
+	};
+
+	// Fraction of new traces that are sampled. Child spans follow their parent's decision.
+	std::atomic<double> SamplingRate = 1.0;
+
+	// Fraction of span events that are added, including those added by EmitLog()
+	std::atomic<double> EventRate = 1.0;
+
+	// Fraction of EmitLog() calls that are passed on. Errors are always passed on.
+	std::atomic<double> LogRate = 1.0;
+
+	FQueue SpanQueue;
+	FQueue LogQueue;
+
+	bool ShouldCaptureEvent();
+	bool ShouldRouteLog();
+
+	// Samples new traces at SamplingRate and, while that's below 1, records the rate on their root span as
+	// sampling_rate, so backends can scale counts back up
+	std::unique_ptr<otel::sdk::trace::Sampler> CreateSampler();
+
+	// Batch processors that report their queue fill into SpanQueue and LogQueue
+	std::unique_ptr<otel::sdk::trace::SpanProcessor> CreateSpanProcessor(std::unique_ptr<otel::sdk::trace::SpanExporter> Exporter, const otel::sdk::trace::BatchSpanProcessorOptions& Options);
+	std::unique_ptr<otel::sdk::logs::LogRecordProcessor> CreateLogProcessor(std::unique_ptr<otel::sdk::logs::LogRecordExporter> Exporter, const otel::sdk::logs::BatchLogRecordProcessorOptions& Options);
+
+private:
+	// Evenly spaced decimation, so a rate of 0.25 keeps every 4th call
+	static bool ShouldKeep(std::atomic<uint64>& Counter, double Rate);
+
+	std::atomic<uint64> EventCounter = 0;
+	std::atomic<uint64> LogCounter = 0;
+};
+
+// Keeps telemetry from amplifying overload: when the plugin's own per-frame overhead goes over budget, or the export
+// queues fill up, span events are throttled first, then new traces. Logs are throttled separately, on the overhead and
+// the log queue. Rates are restored once the pressure has dropped well below the limits, in the reverse order.
+class FOtelBudget : public IOtelCollector
+{
+public:
+	FOtelBudget(FOtelModule& InModule, TSharedRef<FOtelBudgetState> InState);
+	~FOtelBudget();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	double Decrease(double Rate, double Pressure) const;
+	double Increase(double Rate) const;
+
+	FOtelModule& Module;
+	TSharedRef<FOtelBudgetState> State;
+	double FrameBudgetMs = 0.0;
+	double MaxQueueFill = 0.0;
+	double MinRate = 0.0;
+
+	uint64 LastFrameCounter = 0;
+	uint64 LastTotalCycles = 0;
+
+	TArray<TSharedPtr<FOtelObservableInstrument>> Instruments;
+};
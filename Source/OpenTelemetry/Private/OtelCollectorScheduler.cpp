@@ -0,0 +1,173 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelCollectorScheduler.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOtelCollectors, Log, All);
+
+FOtelCollectorScheduler::FOtelCollectorScheduler(const FOtelCollectorsConfig& InConfig)
+	: Config(InConfig)
+{
+}
+
+FOtelCollectorScheduler::~FOtelCollectorScheduler()
+{
+	for (FEntry& Entry : Entries)
+	{
+		UE_LOG(LogOtelCollectors, Warning, TEXT("Collector %s was not unregistered before shutdown."), *Entry.Collector->GetName().ToString());
+		WaitForTask(Entry);
+		IConsoleManager::Get().UnregisterConsoleObject(Entry.EnabledCVar);
+	}
+}
+
+void FOtelCollectorScheduler::Register(IOtelCollector* Collector)
+{
+	check(IsInGameThread());
+	check(Collector);
+
+	const FName Name = Collector->GetName();
+	if (Entries.ContainsByPredicate([Name](const FEntry& Entry) { return Entry.Collector->GetName() == Name; }))
+	{
+		UE_LOG(LogOtelCollectors, Error, TEXT("A collector named %s is already registered - ignoring the new one."), *Name.ToString());
+		return;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Collector = Collector;
+	Entry.Settings = Collector->GetDefaultSettings();
+
+	if (const FOtelCollectorConfig* Override = Config.Overrides.Find(Name))
+	{
+		if (Override->bEnabled.IsSet())
+		{
+			Entry.Settings.bEnabled = *Override->bEnabled;
+		}
+		if (Override->IntervalMs.IsSet())
+		{
+			Entry.Settings.IntervalSeconds = FMath::Max(0, *Override->IntervalMs) / 1000.0;
+		}
+	}
+
+	const FString CVarName = FString::Printf(TEXT("otel.Collector.%s"), *Name.ToString());
+	Entry.EnabledCVar = IConsoleManager::Get().RegisterConsoleVariable(*CVarName, Entry.Settings.bEnabled, TEXT("Enables the otel collector of the same name."), ECVF_Default);
+
+	// Spread collectors with the same interval over it, rather than having them all come due on the same frame
+	const double Now = FPlatformTime::Seconds();
+	const double Phase = FMath::Frac(Entries.Num() * 0.618034);
+	Entry.LastCollectTime = Now;
+	Entry.NextCollectTime = Now + Entry.Settings.IntervalSeconds * Phase;
+}
+
+void FOtelCollectorScheduler::Unregister(IOtelCollector* Collector)
+{
+	check(IsInGameThread());
+
+	const int32 Index = Entries.IndexOfByPredicate([Collector](const FEntry& Entry) { return Entry.Collector == Collector; });
+	if (Index != INDEX_NONE)
+	{
+		FEntry& Entry = Entries[Index];
+		WaitForTask(Entry);
+		IConsoleManager::Get().UnregisterConsoleObject(Entry.EnabledCVar);
+		Entries.RemoveAt(Index);
+	}
+}
+
+ETickableTickType FOtelCollectorScheduler::GetTickableTickType() const
+{
+	return ETickableTickType::Always;
+}
+
+bool FOtelCollectorScheduler::IsTickableWhenPaused() const
+{
+	return true;
+}
+
+bool FOtelCollectorScheduler::IsTickableInEditor() const
+{
+	return true;
+}
+
+TStatId FOtelCollectorScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FOtelCollectorScheduler, STATGROUP_Tickables);
+}
+
+void FOtelCollectorScheduler::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	DueEntries.Reset();
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		FEntry& Entry = Entries[i];
+		if (Entry.EnabledCVar->GetBool() == false)
+		{
+			continue;
+		}
+
+		if (Entry.Settings.IntervalSeconds <= 0.0)
+		{
+			RunCollector(Entry, Now);
+		}
+		else if (Now >= Entry.NextCollectTime)
+		{
+			DueEntries.Add(i);
+		}
+	}
+
+	// Most overdue first, so deferred collectors can't be starved by ones with shorter intervals
+	DueEntries.Sort([this](int32 A, int32 B)
+		{
+			return Entries[A].NextCollectTime < Entries[B].NextCollectTime;
+		});
+
+	const int32 NumToRun = FMath::Min(DueEntries.Num(), FMath::Max(1, Config.MaxCollectionsPerFrame));
+	for (int32 i = 0; i < NumToRun; ++i)
+	{
+		FEntry& Entry = Entries[DueEntries[i]];
+		RunCollector(Entry, Now);
+
+		// Keep the phase stable, but don't try to catch up on intervals that were missed entirely
+		Entry.NextCollectTime += Entry.Settings.IntervalSeconds;
+		if (Entry.NextCollectTime <= Now)
+		{
+			Entry.NextCollectTime = Now + Entry.Settings.IntervalSeconds;
+		}
+	}
+}
+
+void FOtelCollectorScheduler::RunCollector(FEntry& Entry, double Now)
+{
+	const double DeltaSeconds = Now - Entry.LastCollectTime;
+
+	if (Entry.Settings.Thread == EOtelCollectorThread::AnyThread)
+	{
+		if (Entry.Task.IsValid() && Entry.Task.IsCompleted() == false)
+		{
+			return;
+		}
+
+		IOtelCollector* Collector = Entry.Collector;
+		Entry.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Collector, DeltaSeconds]()
+			{
+				Collector->Collect(DeltaSeconds);
+			},
+			UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+	else
+	{
+		Entry.Collector->Collect(DeltaSeconds);
+	}
+
+	Entry.LastCollectTime = Now;
+}
+
+void FOtelCollectorScheduler::WaitForTask(FEntry& Entry)
+{
+	if (Entry.Task.IsValid())
+	{
+		Entry.Task.Wait();
+		Entry.Task = UE::Tasks::FTask();
+	}
+}
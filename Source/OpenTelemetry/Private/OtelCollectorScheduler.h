@@ -0,0 +1,48 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+#include "Tasks/Task.h"
+#include "Tickable.h"
+
+class IConsoleVariable;
+
+// Runs registered IOtelCollectors at their configured cadence. Collectors with an interval are given staggered phases
+// when they're registered, and at most FOtelCollectorsConfig::MaxCollectionsPerFrame of them are run per frame, with
+// the most overdue ones going first, so the telemetry cost per frame stays flat instead of spiking whenever intervals
+// line up. AnyThread collectors only cost the game thread a task launch.
+class FOtelCollectorScheduler : public FTickableGameObject
+{
+public:
+	FOtelCollectorScheduler(const FOtelCollectorsConfig& InConfig);
+	~FOtelCollectorScheduler();
+
+	void Register(IOtelCollector* Collector);
+	void Unregister(IOtelCollector* Collector);
+
+	// FTickableGameObject
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual bool IsTickableInEditor() const override;
+	virtual TStatId GetStatId() const override;
+	virtual void Tick(float DeltaTime) override;
+
+private:
+	struct FEntry
+	{
+		IOtelCollector* Collector = nullptr;
+		FOtelCollectorSettings Settings;
+		IConsoleVariable* EnabledCVar = nullptr;
+		double NextCollectTime = 0.0;
+		double LastCollectTime = 0.0;
+		UE::Tasks::FTask Task;
+	};
+
+	void RunCollector(FEntry& Entry, double Now);
+	static void WaitForTask(FEntry& Entry);
+
+	FOtelCollectorsConfig Config;
+	TArray<FEntry> Entries;
+	TArray<int32> DueEntries;
+};
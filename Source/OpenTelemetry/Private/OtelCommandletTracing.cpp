@@ -0,0 +1,172 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelCommandletTracing.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+
+// Longer than the flush on module shutdown, since this is usually the last chance the spans have to get out
+static const double ExitFlushTimeoutSeconds = 5.0;
+
+FOtelCommandletTracing::FOtelCommandletTracing(FOtelModule& InModule)
+	: Module(InModule)
+	, bEngineInitialized(GIsRunning)
+{
+	if (IsRunningCommandlet())
+	{
+		FString CommandletName;
+		FParse::Value(FCommandLine::Get(), TEXT("-run="), CommandletName);
+
+		const FAnalyticsEventAttribute Attributes[] = { FAnalyticsEventAttribute(TEXT("commandlet"), CommandletName) };
+
+		// GStartTime is taken during static init, so this covers engine startup too
+		const int64 UptimeNanoseconds = static_cast<int64>((FPlatformTime::Seconds() - GStartTime) * 1e9);
+		FOtelTimestamp StartTime = FOtelTimestamp::Now();
+		StartTime.System -= UptimeNanoseconds;
+		StartTime.Steady -= UptimeNanoseconds;
+
+		CommandletSpan = Module.GetTracer().StartSpanOpts(TEXT("Commandlet"), TEXT(__FILE__), __LINE__, nullptr, Attributes, &StartTime);
+		BindExit();
+	}
+
+#if WITH_AUTOMATION_TESTS
+	FAutomationTestFramework::Get().OnTestStartEvent.AddRaw(this, &FOtelCommandletTracing::OnTestStart);
+	FAutomationTestFramework::Get().OnTestEndEvent.AddRaw(this, &FOtelCommandletTracing::OnTestEnd);
+#endif
+
+	FCoreDelegates::OnPostEngineInit.AddRaw(this, &FOtelCommandletTracing::OnPostEngineInit);
+}
+
+FOtelCommandletTracing::~FOtelCommandletTracing()
+{
+#if WITH_AUTOMATION_TESTS
+	FAutomationTestFramework::Get().OnTestStartEvent.RemoveAll(this);
+	FAutomationTestFramework::Get().OnTestEndEvent.RemoveAll(this);
+#endif
+
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+	FCoreDelegates::OnEnginePreExit.RemoveAll(this);
+	FCoreDelegates::GetApplicationWillTerminateDelegate().RemoveAll(this);
+
+	// Only commandlets and test runs hold spans open until exit
+	if (bBoundExit)
+	{
+		OnExit();
+	}
+}
+
+void FOtelCommandletTracing::BindExit()
+{
+	if (bBoundExit)
+	{
+		return;
+	}
+	bBoundExit = true;
+
+	// Pre-exit is bound once the engine is up, see OnPostEngineInit(). Forced exits skip pre-exit, but still say the
+	// application is terminating.
+	FCoreDelegates::GetApplicationWillTerminateDelegate().AddRaw(this, &FOtelCommandletTracing::OnExit);
+	if (bEngineInitialized)
+	{
+		FCoreDelegates::OnEnginePreExit.AddRaw(this, &FOtelCommandletTracing::OnExit);
+	}
+}
+
+void FOtelCommandletTracing::OnPostEngineInit()
+{
+	bEngineInitialized = true;
+
+	// Bound this late so it runs after the pre-exit handlers of modules loaded during startup, which may still end
+	// spans under the commandlet's
+	if (bBoundExit)
+	{
+		FCoreDelegates::OnEnginePreExit.AddRaw(this, &FOtelCommandletTracing::OnExit);
+	}
+}
+
+void FOtelCommandletTracing::OnTestStart(FAutomationTestBase* Test)
+{
+	if (bExited || Test == nullptr)
+	{
+		return;
+	}
+
+	// Tests run from the editor or a game's command line get flushed on exit too, since they're usually in CI
+	BindExit();
+
+	const FAnalyticsEventAttribute Attributes[] = { FAnalyticsEventAttribute(TEXT("test"), Test->GetTestFullName()) };
+
+	FOtelSpan TestSpan = Module.GetTracer().StartSpanOpts(TEXT("AutomationTest"), TEXT(__FILE__), __LINE__, &CommandletSpan, Attributes);
+	TestSpans.Add(Test, TestSpan);
+}
+
+void FOtelCommandletTracing::OnTestEnd(FAutomationTestBase* Test)
+{
+	FOtelSpan TestSpan;
+	if (TestSpans.RemoveAndCopyValue(Test, TestSpan) == false)
+	{
+		return;
+	}
+
+	FAutomationTestExecutionInfo ExecutionInfo;
+	Test->GetExecutionInfo(ExecutionInfo);
+
+	const bool bSucceeded = Test->HasAnyErrors() == false;
+	++NumTests;
+	NumFailedTests += bSucceeded ? 0 : 1;
+
+	const FAnalyticsEventAttribute Attributes[] = {
+		FAnalyticsEventAttribute(TEXT("errors"), ExecutionInfo.GetErrorTotal()),
+		FAnalyticsEventAttribute(TEXT("warnings"), ExecutionInfo.GetWarningTotal())
+	};
+	TestSpan.AddAttributes(Attributes);
+	TestSpan.SetStatus(bSucceeded ? EOtelStatus::Ok : EOtelStatus::Error);
+	TestSpan.End();
+}
+
+void FOtelCommandletTracing::OnExit()
+{
+	if (bExited)
+	{
+		return;
+	}
+	bExited = true;
+
+	// Tests still running at exit didn't get to finish, which counts as failing
+	for (TPair<FAutomationTestBase*, FOtelSpan>& Pair : TestSpans)
+	{
+		Pair.Value.AddAttribute(FAnalyticsEventAttribute(TEXT("interrupted"), true));
+		Pair.Value.SetStatus(EOtelStatus::Error);
+		Pair.Value.End();
+		++NumTests;
+		++NumFailedTests;
+	}
+	TestSpans.Empty();
+
+	if (CommandletSpan.OtelSpan)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("tests"), NumTests),
+			FAnalyticsEventAttribute(TEXT("failed_tests"), NumFailedTests)
+		};
+		CommandletSpan.AddAttributes(Attributes);
+
+		if (GIsCriticalError)
+		{
+			CommandletSpan.AddAttribute(FAnalyticsEventAttribute(TEXT("critical_error"), true));
+		}
+
+		if (ExitCode.IsSet())
+		{
+			CommandletSpan.AddAttribute(FAnalyticsEventAttribute(TEXT("exit_code"), *ExitCode));
+		}
+
+		const bool bFailed = GIsCriticalError || NumFailedTests > 0 || (ExitCode.IsSet() && *ExitCode != 0);
+		CommandletSpan.SetStatus(bFailed ? EOtelStatus::Error : EOtelStatus::Ok);
+		CommandletSpan.End();
+		CommandletSpan = FOtelSpan();
+	}
+
+	Module.ForceFlush(ExitFlushTimeoutSeconds);
+}
@@ -0,0 +1,42 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+class FAutomationTestBase;
+
+// Gives a commandlet run a Commandlet root span from process start to engine exit, and each automation test an
+// AutomationTest span with its result as the span status. Tests run from a commandlet are children of its span. The
+// commandlet span fails on a critical error, a failed test, or a non-zero exit code when one was recorded. In
+// commandlets and processes that ran tests, the spans are ended and the tracer is flushed on engine exit, since build
+// agents often tear the process down without unloading modules.
+class FOtelCommandletTracing
+{
+public:
+	FOtelCommandletTracing(FOtelModule& InModule);
+	~FOtelCommandletTracing();
+
+	// The Commandlet span, which isn't valid outside of commandlets or after exit
+	const FOtelSpan& GetCommandletSpan() const { return CommandletSpan; }
+
+	// See FOtelModule::SetCommandletExitCode
+	void SetExitCode(int32 InExitCode) { ExitCode = InExitCode; }
+
+private:
+	void BindExit();
+	void OnPostEngineInit();
+	void OnTestStart(FAutomationTestBase* Test);
+	void OnTestEnd(FAutomationTestBase* Test);
+	void OnExit();
+
+	FOtelModule& Module;
+	FOtelSpan CommandletSpan;
+	TMap<FAutomationTestBase*, FOtelSpan> TestSpans;
+	int32 NumTests = 0;
+	int32 NumFailedTests = 0;
+	TOptional<int32> ExitCode;
+	bool bEngineInitialized = false;
+	bool bBoundExit = false;
+	bool bExited = false;
+};
@@ -0,0 +1,291 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelCsvStats.h"
+#include "Otel.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "String/ParseTokens.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOtelCsv, Log, All);
+
+// Stats that aren't registered in a named category show up without a prefix in the capture header
+static const TCHAR* CsvDefaultCategoryName = TEXT("Default");
+
+// Captures are read this much at a time, so even hour-long ones only ever have a chunk and a few rows in memory
+static constexpr int64 CsvReadChunkBytes = 64 * 1024;
+
+// Calls Visitor with each line of the file, without line endings
+static bool VisitCsvLines(const TCHAR* Filename, TFunctionRef<void(FStringView Line)> Visitor)
+{
+	TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(Filename));
+	if (File.IsValid() == false)
+	{
+		return false;
+	}
+
+	TArray<uint8> Chunk;
+	Chunk.SetNumUninitialized(CsvReadChunkBytes);
+
+	// A line can span chunks, so it's gathered here until its end is found
+	TArray<UTF8CHAR> Line;
+
+	auto VisitLine = [&Line, &Visitor]()
+	{
+		const auto Converted = StringCast<TCHAR>(Line.GetData(), Line.Num());
+		Visitor(FStringView(Converted.Get(), Converted.Length()));
+		Line.Reset();
+	};
+
+	int64 RemainingBytes = File->Size();
+	while (RemainingBytes > 0)
+	{
+		const int64 ChunkBytes = FMath::Min(RemainingBytes, CsvReadChunkBytes);
+		if (File->Read(Chunk.GetData(), ChunkBytes) == false)
+		{
+			return false;
+		}
+		RemainingBytes -= ChunkBytes;
+
+		for (int64 Index = 0; Index < ChunkBytes; ++Index)
+		{
+			const uint8 Char = Chunk[Index];
+			if (Char == '\n')
+			{
+				VisitLine();
+			}
+			else if (Char != '\r')
+			{
+				Line.Add(static_cast<UTF8CHAR>(Char));
+			}
+		}
+	}
+
+	if (Line.Num() > 0)
+	{
+		VisitLine();
+	}
+	return true;
+}
+
+FOtelCsvStats::FOtelCsvStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+#if CSV_PROFILER
+	const FOtelStatsConfig& Config = Module.GetConfig().Stats;
+	if (Config.CsvCategories.IsEmpty())
+	{
+		return;
+	}
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("csv_stats"));
+
+	for (const FString& CategoryName : Config.CsvCategories)
+	{
+		if (CategoryName != CsvDefaultCategoryName)
+		{
+			FCsvProfiler::Get()->EnableCategoryByString(CategoryName);
+		}
+
+		// Categories freely mix timings and counts, so there's no single set of buckets that fits - fall back to the
+		// otel default buckets
+		const FString HistogramName = FString::Printf(TEXT("csv_stats_%s"), *CategoryName.ToLower());
+
+		FCategory& Category = Categories.AddDefaulted_GetRef();
+		Category.Name = CategoryName;
+		Category.Histogram = Meter.CreateHistogram(EOtelInstrumentType::Double, *HistogramName, FOtelHistogramBuckets());
+	}
+
+	OnCsvProfileFinishedHandle = FCsvProfiler::Get()->OnCSVProfileFinished().AddRaw(this, &FOtelCsvStats::OnCsvProfileFinished);
+
+	CaptureFrames = Config.CsvCaptureFrames;
+	if (CaptureFrames > 0)
+	{
+		CaptureFolder = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("OtelCsv");
+		Module.RegisterCollector(this);
+		bRegistered = true;
+	}
+#endif
+}
+
+FOtelCsvStats::~FOtelCsvStats()
+{
+	if (bRegistered)
+	{
+		Module.UnregisterCollector(this);
+	}
+
+#if CSV_PROFILER
+	if (OnCsvProfileFinishedHandle.IsValid())
+	{
+		FCsvProfiler::Get()->OnCSVProfileFinished().Remove(OnCsvProfileFinishedHandle);
+	}
+#endif
+
+	for (TFuture<void>& Export : PendingExports)
+	{
+		Export.Wait();
+	}
+}
+
+FName FOtelCsvStats::GetName() const
+{
+	return TEXT("CsvStats");
+}
+
+FOtelCollectorSettings FOtelCsvStats::GetDefaultSettings() const
+{
+	// Only starts the next rolling capture, so a second between captures is plenty
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 1.0;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
+
+void FOtelCsvStats::Collect(double DeltaSeconds)
+{
+#if CSV_PROFILER
+	// Captures started by the command line, console or game code take precedence, and are exported all the same
+	FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+	if (CsvProfiler->IsCapturing() || CsvProfiler->IsWritingFile())
+	{
+		return;
+	}
+
+	CsvProfiler->BeginCapture(CaptureFrames, CaptureFolder);
+#endif
+}
+
+void FOtelCsvStats::OnCsvProfileFinished(const FString& Filename)
+{
+	PendingExports.RemoveAll([](const TFuture<void>& Export)
+		{
+			return Export.IsReady();
+		});
+
+	PendingExports.Add(Async(EAsyncExecution::ThreadPool, [this, Filename]()
+		{
+			ExportCapture(Filename);
+
+			// Rolling captures only exist to be exported
+			if (CaptureFolder.IsEmpty() == false && FPaths::IsUnderDirectory(Filename, CaptureFolder))
+			{
+				IFileManager::Get().Delete(*Filename);
+			}
+		}));
+}
+
+void FOtelCsvStats::ExportCapture(const FString& Filename)
+{
+	if (Filename.EndsWith(TEXT(".csv")) == false)
+	{
+		UE_LOG(LogOtelCsv, Display, TEXT("Skipping export of CSV capture %s - only uncompressed text captures are supported."), *Filename);
+		return;
+	}
+
+	// The header row is either first, or for captures that are streamed to disk, repeated right before the trailing
+	// metadata row of [Key],Value pairs once the full set of stats is known. Finding out which takes a first pass.
+	int32 NumLines = 0;
+	FString FirstLine;
+	FString PreviousLine;
+	FString LastLine;
+	const bool bRead = VisitCsvLines(*Filename, [&](FStringView Line)
+		{
+			if (NumLines == 0)
+			{
+				FirstLine = Line;
+			}
+			Swap(PreviousLine, LastLine);
+			LastLine.Reset();
+			LastLine.Append(Line.GetData(), Line.Len());
+			++NumLines;
+		});
+
+	if (bRead == false || NumLines < 2)
+	{
+		UE_LOG(LogOtelCsv, Warning, TEXT("Failed to read CSV capture %s - no stats will be exported."), *Filename);
+		return;
+	}
+
+	int32 EndRow = NumLines;
+	bool bHasHeaderRowAtEnd = false;
+	if (LastLine.StartsWith(TEXT("[")))
+	{
+		bHasHeaderRowAtEnd = LastLine.Contains(TEXT("[HasHeaderRowAtEnd],1"));
+		--EndRow;
+	}
+
+	if (bHasHeaderRowAtEnd)
+	{
+		--EndRow;
+	}
+	const FString& HeaderLine = bHasHeaderRowAtEnd ? PreviousLine : FirstLine;
+
+	struct FColumn
+	{
+		int32 CategoryIndex = INDEX_NONE;
+		TArray<FAnalyticsEventAttribute, TInlineAllocator<1>> Attributes;
+	};
+
+	TArray<FColumn> Columns;
+	UE::String::ParseTokens(HeaderLine, TEXT(','), [this, &Columns](FStringView Cell)
+		{
+			FString CategoryName = CsvDefaultCategoryName;
+			FString StatName = FString(Cell).TrimStartAndEnd();
+
+			int32 SlashIndex = INDEX_NONE;
+			if (StatName.FindChar(TEXT('/'), SlashIndex))
+			{
+				CategoryName = StatName.Left(SlashIndex);
+				StatName.RightChopInline(SlashIndex + 1);
+			}
+
+			FColumn& Column = Columns.AddDefaulted_GetRef();
+			Column.CategoryIndex = Categories.IndexOfByPredicate([&CategoryName](const FCategory& Category)
+				{
+					return Category.Name == CategoryName;
+				});
+
+			if (Column.CategoryIndex != INDEX_NONE)
+			{
+				Column.Attributes.Add(FAnalyticsEventAttribute(TEXT("stat"), MoveTemp(StatName)));
+			}
+		});
+
+	int32 NumSamples = 0;
+	int32 Row = 0;
+	TStringBuilder<64> Cell;
+	VisitCsvLines(*Filename, [&](FStringView Line)
+		{
+			const int32 LineRow = Row++;
+			if (LineRow < 1 || LineRow >= EndRow)
+			{
+				return;
+			}
+
+			int32 ColumnIndex = 0;
+			UE::String::ParseTokens(Line, TEXT(','), [&](FStringView Token)
+				{
+					if (ColumnIndex >= Columns.Num())
+					{
+						return;
+					}
+					FColumn& Column = Columns[ColumnIndex++];
+
+					// Non-numeric columns (e.g. EVENTS) and negative custom stats can't go into a histogram
+					Cell.Reset();
+					Cell << Token;
+					double Value = 0.0;
+					if (Column.CategoryIndex != INDEX_NONE && LexTryParseString(Value, *Cell) && Value >= 0.0)
+					{
+						Categories[Column.CategoryIndex].Histogram->Record(Value, Column.Attributes);
+						++NumSamples;
+					}
+				});
+		});
+
+	UE_LOG(LogOtelCsv, Display, TEXT("Exported %d samples from CSV capture %s"), NumSamples, *Filename);
+}
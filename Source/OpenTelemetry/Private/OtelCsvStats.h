@@ -0,0 +1,41 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+#include "Async/Future.h"
+
+// Exports CSV profiler captures as histograms. Each configured category gets its own histogram, with one series per
+// stat in that category. The CSV profiler doesn't expose per-frame values while capturing, so finished capture files
+// are streamed from disk on a background thread instead, which keeps the game thread cost at zero. With
+// CsvCaptureFrames set, a rolling capture of that many frames is started into a folder of its own whenever no capture
+// is running, and its files are deleted once exported. Captures started by anything else are exported and left alone.
+class FOtelCsvStats : public IOtelCollector
+{
+public:
+	FOtelCsvStats(FOtelModule& InModule);
+	~FOtelCsvStats();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	void OnCsvProfileFinished(const FString& Filename);
+	void ExportCapture(const FString& Filename);
+
+	struct FCategory
+	{
+		FString Name;
+		TSharedPtr<FOtelHistogram> Histogram;
+	};
+
+	FOtelModule& Module;
+	TArray<FCategory> Categories;
+	int32 CaptureFrames = 0;
+	FString CaptureFolder;
+	bool bRegistered = false;
+	TArray<TFuture<void>> PendingExports;
+	FDelegateHandle OnCsvProfileFinishedHandle;
+};
@@ -0,0 +1,203 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelEngineStats.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/CoreDelegates.h"
+#include "Stats/StatsData.h"
+
+#if STATS
+
+static ENamedThreads::Type GetStatsThread()
+{
+	return FPlatformProcess::SupportsMultithreading() ? ENamedThreads::StatsThread : ENamedThreads::GameThread;
+}
+
+static const TCHAR* StatGroupPrefix = TEXT("STATGROUP_");
+
+FOtelEngineStats::FOtelEngineStats(FOtelModule& InModule)
+{
+	const FOtelStatsConfig& Config = InModule.GetConfig().Stats;
+	if (Config.EngineStats.IsEmpty() && Config.EngineStatGroups.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FString& StatName : Config.EngineStats)
+	{
+		StatNames.Add(FName(*StatName));
+	}
+
+	for (const FString& GroupName : Config.EngineStatGroups)
+	{
+		// Accept both Engine and STATGROUP_Engine in the config - the enable command wants the former, while stat
+		// messages carry the latter
+		const FString ShortGroupName = GroupName.StartsWith(StatGroupPrefix) ? GroupName.RightChop(FCString::Strlen(StatGroupPrefix)) : GroupName;
+		GroupNames.Add(FName(StatGroupPrefix + ShortGroupName));
+		IStatGroupEnableManager::Get().StatGroupEnableManagerCommand(FString::Printf(TEXT("enable %s"), *ShortGroupName));
+	}
+
+	StatsPrimaryEnableAdd();
+	bEnabledStats = true;
+
+	FOtelMeter Meter = InModule.GetMeter(TEXT("engine_stats"));
+
+	const double CycleBucketsRaw[] = { 0.01, 0.05, 0.1, 0.25, 0.5, 1, 2, 4, 8, 16.6667, 33.3334 };
+	const FOtelHistogramBuckets CycleBuckets = FOtelHistogramBuckets::From(CycleBucketsRaw);
+
+	HistogramCycles = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("engine_stats_cycles"), CycleBuckets, EUnit::Milliseconds);
+	GaugeValues = Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("engine_stats_value"), [this](FOtelObserver& Observer)
+		{
+			ObserveValues(Observer);
+		});
+
+	// The new frame delegate is broadcast from the stats thread, so it also has to be bound there
+	FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+		{
+			NewFrameHandle = FStatsThreadState::GetLocalState().NewFrameDelegate.AddRaw(this, &FOtelEngineStats::OnNewStatsFrame);
+		},
+		TStatId(), nullptr, GetStatsThread());
+	bBoundNewFrame = true;
+
+	// The stats thread can already be stopped by the time modules shut down, and waiting on it then would hang, so the
+	// delegate is unbound while it's still running
+	FCoreDelegates::OnEnginePreExit.AddRaw(this, &FOtelEngineStats::UnbindNewFrame);
+}
+
+FOtelEngineStats::~FOtelEngineStats()
+{
+	if (bEnabledStats == false)
+	{
+		return;
+	}
+
+	FCoreDelegates::OnEnginePreExit.RemoveAll(this);
+
+	// Only still bound when the module is unloaded before engine exit, while the stats thread is running
+	if (FTaskGraphInterface::IsRunning())
+	{
+		UnbindNewFrame();
+	}
+
+	GaugeValues.Reset();
+	StatsPrimaryEnableSubtract();
+}
+
+void FOtelEngineStats::UnbindNewFrame()
+{
+	if (bBoundNewFrame == false)
+	{
+		return;
+	}
+
+	bBoundNewFrame = false;
+
+	FGraphEventRef UnbindTask = FFunctionGraphTask::CreateAndDispatchWhenReady([this]()
+		{
+			FStatsThreadState::GetLocalState().NewFrameDelegate.Remove(NewFrameHandle);
+		},
+		TStatId(), nullptr, GetStatsThread());
+	FTaskGraphInterface::Get().WaitUntilTaskCompletes(UnbindTask);
+}
+
+void FOtelEngineStats::OnNewStatsFrame(int64 Frame)
+{
+	const FStatsThreadState& StatsState = FStatsThreadState::GetLocalState();
+	if (StatsState.IsFrameValid(Frame) == false)
+	{
+		return;
+	}
+
+	// Decoding short and group names out of a raw stat name isn't free, so the decision is cached per raw name
+	struct FStatFilter : public IItemFilter
+	{
+		FOtelEngineStats& Stats;
+
+		FStatFilter(FOtelEngineStats& InStats)
+			: Stats(InStats)
+		{
+		}
+
+		virtual bool Keep(const FStatMessage& Item) override
+		{
+			const FName RawName = Item.NameAndInfo.GetRawName();
+			if (const bool* bIsExported = Stats.RawNameIsExported.Find(RawName))
+			{
+				return *bIsExported;
+			}
+
+			const bool bIsExported = Stats.StatNames.Contains(Item.NameAndInfo.GetShortName()) || Stats.GroupNames.Contains(Item.NameAndInfo.GetGroupName());
+			Stats.RawNameIsExported.Add(RawName, bIsExported);
+			return bIsExported;
+		}
+	};
+
+	FStatFilter Filter(*this);
+	StatMessages.Reset();
+	StatsState.GetInclusiveAggregateStackStats(Frame, StatMessages, &Filter);
+
+	FOtelLockedData<TMap<FName, FStatValue>> Values = LatestValues.Lock();
+	for (const FStatMessage& Message : StatMessages)
+	{
+		const FName ShortName = Message.NameAndInfo.GetShortName();
+
+		if (Message.NameAndInfo.GetFlag(EStatMetaFlags::IsCycle))
+		{
+			TArray<FAnalyticsEventAttribute>* Attributes = CycleAttributes.Find(ShortName);
+			if (Attributes == nullptr)
+			{
+				Attributes = &CycleAttributes.Add(ShortName);
+				Attributes->Add(FAnalyticsEventAttribute(TEXT("stat"), ShortName.ToString()));
+				Attributes->Add(FAnalyticsEventAttribute(TEXT("group"), Message.NameAndInfo.GetGroupName().ToString()));
+			}
+
+			const double DurationMs = FPlatformTime::ToMilliseconds(Message.GetValue_Duration());
+			HistogramCycles->Record(DurationMs, *Attributes);
+		}
+		else
+		{
+			double Value = 0.0;
+			switch (Message.NameAndInfo.GetField<EStatDataType>())
+			{
+				case EStatDataType::ST_int64:
+					Value = static_cast<double>(Message.GetValue_int64());
+					break;
+				case EStatDataType::ST_double:
+					Value = Message.GetValue_double();
+					break;
+				default:
+					continue;
+			}
+
+			FStatValue& StatValue = Values->FindOrAdd(ShortName);
+			StatValue.GroupName = Message.NameAndInfo.GetGroupName();
+			StatValue.Value = Value;
+		}
+	}
+}
+
+void FOtelEngineStats::ObserveValues(FOtelObserver& Observer)
+{
+	FOtelLockedData<TMap<FName, FStatValue>> Values = LatestValues.Lock();
+	for (const TPair<FName, FStatValue>& Pair : *Values)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("stat"), Pair.Key.ToString()),
+			FAnalyticsEventAttribute(TEXT("group"), Pair.Value.GroupName.ToString()),
+		};
+
+		Observer.Observe(Pair.Value.Value, Attributes);
+	}
+}
+
+#else
+
+FOtelEngineStats::FOtelEngineStats(FOtelModule& InModule)
+{
+}
+
+FOtelEngineStats::~FOtelEngineStats()
+{
+}
+
+#endif // STATS
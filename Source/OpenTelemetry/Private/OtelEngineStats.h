@@ -0,0 +1,50 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+#include "Stats/Stats.h"
+
+#if STATS
+struct FStatMessage;
+#endif
+
+// Bridges the engine stats system into otel. The configured STAT_ counters and every stat in the configured groups are
+// read on the stats thread whenever a stats frame completes, so the game thread never pays for it. Cycle counters are
+// recorded into a histogram every frame, and everything else (memory, counters) keeps only its latest value, which is
+// reported as a gauge when metrics are collected for export.
+class FOtelEngineStats
+{
+public:
+	FOtelEngineStats(FOtelModule& InModule);
+	~FOtelEngineStats();
+
+private:
+#if STATS
+	void OnNewStatsFrame(int64 Frame);
+	void UnbindNewFrame();
+	void ObserveValues(FOtelObserver& Observer);
+
+	struct FStatValue
+	{
+		FName GroupName;
+		double Value = 0.0;
+	};
+
+	TSet<FName> StatNames;
+	TSet<FName> GroupNames;
+
+	TSharedPtr<FOtelHistogram> HistogramCycles;
+	TSharedPtr<FOtelObservableInstrument> GaugeValues;
+	FOtelUnlockedData<TMap<FName, FStatValue>> LatestValues;
+
+	// Only accessed from the stats thread
+	TMap<FName, bool> RawNameIsExported;
+	TMap<FName, TArray<FAnalyticsEventAttribute>> CycleAttributes;
+	TArray<FStatMessage> StatMessages;
+	FDelegateHandle NewFrameHandle;
+
+	bool bEnabledStats = false;
+	bool bBoundNewFrame = false;
+#endif
+};
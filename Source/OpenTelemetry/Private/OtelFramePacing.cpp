@@ -0,0 +1,170 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelFramePacing.h"
+#include "OtelWorldTracker.h"
+
+FOtelFramePacing::FOtelFramePacing(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker)
+	: Module(InModule)
+	, WorldTracker(InWorldTracker)
+{
+	const FOtelConfig& Config = Module.GetConfig();
+	BudgetMs = Config.Stats.FrameBudgetMs;
+
+	for (const FString& Threshold : Config.Stats.StutterThresholdsMs)
+	{
+		const double ThresholdMs = FCString::Atod(*Threshold);
+		if (ThresholdMs > 0.0)
+		{
+			StutterThresholdsMs.Add(ThresholdMs);
+			StutterThresholdNames.Add(Threshold.TrimStartAndEnd());
+		}
+	}
+
+	Current.Lock()->Stutters.SetNumZeroed(StutterThresholdsMs.Num());
+	Snapshot.Stutters.SetNumZeroed(StutterThresholdsMs.Num());
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("frame_pacing"));
+
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("frame_pacing_delta_stddev"), [this, Index = Instruments.Num()](FOtelObserver& Observer)
+		{
+			UpdateSnapshot(Index);
+			if (Snapshot.NumDeltas > 0)
+			{
+				const double NumDeltas = static_cast<double>(Snapshot.NumDeltas);
+				const double Mean = Snapshot.SumDelta / NumDeltas;
+				const double Variance = FMath::Max(0.0, Snapshot.SumDeltaSquared / NumDeltas - Mean * Mean);
+				Observer.Observe(FMath::Sqrt(Variance), {});
+			}
+		},
+		EUnit::Milliseconds));
+
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("frame_pacing_stutters"), [this, Index = Instruments.Num()](FOtelObserver& Observer)
+		{
+			UpdateSnapshot(Index);
+			for (int32 i = 0; i < StutterThresholdNames.Num(); ++i)
+			{
+				const FAnalyticsEventAttribute Attributes[] = { FAnalyticsEventAttribute(TEXT("threshold_ms"), StutterThresholdNames[i]) };
+				Observer.Observe(Snapshot.Stutters[i], Attributes);
+			}
+		}));
+
+	if (BudgetMs > 0.0)
+	{
+		Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("frame_pacing_frames_over_budget_pct"), [this, Index = Instruments.Num()](FOtelObserver& Observer)
+			{
+				UpdateSnapshot(Index);
+				if (Snapshot.NumFrames > 0)
+				{
+					Observer.Observe(static_cast<double>(Snapshot.NumFramesOverBudget) / static_cast<double>(Snapshot.NumFrames), {});
+				}
+			}));
+
+		Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("frame_pacing_time_over_budget_pct"), [this, Index = Instruments.Num()](FOtelObserver& Observer)
+			{
+				UpdateSnapshot(Index);
+				if (Snapshot.TotalMs > 0.0)
+				{
+					Observer.Observe(Snapshot.OverBudgetMs / Snapshot.TotalMs, {});
+				}
+			}));
+	}
+
+	Module.RegisterCollector(this);
+}
+
+FOtelFramePacing::~FOtelFramePacing()
+{
+	Module.UnregisterCollector(this);
+
+	// Unregister the callbacks before the snapshot they use goes away
+	Instruments.Reset();
+}
+
+FName FOtelFramePacing::GetName() const
+{
+	return TEXT("FramePacing");
+}
+
+FOtelCollectorSettings FOtelFramePacing::GetDefaultSettings() const
+{
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 0.0;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
+
+void FOtelFramePacing::Collect(double DeltaSeconds)
+{
+	// The editor only has frames worth reporting while playing in editor
+	if (GIsEditor && WorldTracker.GetWorlds().IsEmpty())
+	{
+		return;
+	}
+
+	// Every-frame collectors are called once per frame, so the time since the last call is the frame time. After a gap,
+	// e.g. the collector being disabled or the editor not playing, it spans every frame since, so it's dropped and the
+	// next frame isn't compared to the one before the gap.
+	const uint64 FrameCounter = GFrameCounter;
+	const bool bContiguous = LastCollectFrame != 0 && FrameCounter == LastCollectFrame + 1;
+	LastCollectFrame = FrameCounter;
+	if (bContiguous == false)
+	{
+		bHasPreviousFrame = false;
+		return;
+	}
+
+	const double FrameMs = DeltaSeconds * 1000.0;
+	const double RollingAverageMs = (WindowCount > 0) ? (WindowSum / WindowCount) : FrameMs;
+
+	{
+		FOtelLockedData<FInterval> Interval = Current.Lock();
+
+		if (bHasPreviousFrame)
+		{
+			const double Delta = FrameMs - PreviousFrameMs;
+			++Interval->NumDeltas;
+			Interval->SumDelta += Delta;
+			Interval->SumDeltaSquared += Delta * Delta;
+		}
+
+		++Interval->NumFrames;
+		Interval->TotalMs += FrameMs;
+
+		if (BudgetMs > 0.0 && FrameMs > BudgetMs)
+		{
+			++Interval->NumFramesOverBudget;
+			Interval->OverBudgetMs += FrameMs - BudgetMs;
+		}
+
+		for (int32 i = 0; i < StutterThresholdsMs.Num(); ++i)
+		{
+			if (FrameMs - RollingAverageMs > StutterThresholdsMs[i])
+			{
+				++Interval->Stutters[i];
+			}
+		}
+	}
+
+	PreviousFrameMs = FrameMs;
+	bHasPreviousFrame = true;
+
+	WindowSum += FrameMs - Window[WindowNext];
+	Window[WindowNext] = FrameMs;
+	WindowNext = (WindowNext + 1) % WindowSize;
+	WindowCount = FMath::Min(WindowCount + 1, WindowSize);
+}
+
+void FOtelFramePacing::UpdateSnapshot(int32 InstrumentIndex)
+{
+	if (SnapshotGate.BeginObserve(InstrumentIndex) == false)
+	{
+		return;
+	}
+
+	FOtelLockedData<FInterval> Interval = Current.Lock();
+	Snapshot = *Interval;
+
+	const int32 NumThresholds = Interval->Stutters.Num();
+	*Interval = FInterval();
+	Interval->Stutters.SetNumZeroed(NumThresholds);
+}
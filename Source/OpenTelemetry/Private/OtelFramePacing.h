@@ -0,0 +1,63 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+class FOtelWorldTracker;
+
+// Analyses frame pacing locally so only a handful of values per export interval leave the process: the standard
+// deviation of frame-to-frame time changes, the number of stutters (frames that exceed the rolling average frame time
+// by more than each configured threshold), and the percentage of frames and time over the frame budget. Unlike the
+// frame time histograms, these distinguish a steady frame rate from one alternating between fast and slow frames. Like
+// the frame stats, the editor is only measured while playing in editor.
+class FOtelFramePacing : public IOtelCollector
+{
+public:
+	FOtelFramePacing(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker);
+	~FOtelFramePacing();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	struct FInterval
+	{
+		int64 NumFrames = 0;
+		int64 NumDeltas = 0;
+		int64 NumFramesOverBudget = 0;
+		double TotalMs = 0.0;
+		double OverBudgetMs = 0.0;
+		double SumDelta = 0.0;
+		double SumDeltaSquared = 0.0;
+		TArray<int64, TInlineAllocator<4>> Stutters;
+	};
+
+	void UpdateSnapshot(int32 InstrumentIndex);
+
+	FOtelModule& Module;
+	FOtelWorldTracker& WorldTracker;
+	double BudgetMs = 0.0;
+	TArray<double> StutterThresholdsMs;
+	TArray<FString> StutterThresholdNames;
+
+	// Rolling window of recent frame times, only accessed on the game thread
+	static constexpr int32 WindowSize = 32;
+	double Window[WindowSize] = {};
+	double WindowSum = 0.0;
+	int32 WindowNext = 0;
+	int32 WindowCount = 0;
+	double PreviousFrameMs = 0.0;
+	bool bHasPreviousFrame = false;
+	uint64 LastCollectFrame = 0;
+
+	FOtelUnlockedData<FInterval> Current;
+
+	// Only accessed from the exporter thread. All gauges of one collection report the same snapshot.
+	FOtelSnapshotGate SnapshotGate;
+	FInterval Snapshot;
+
+	TArray<TSharedPtr<FOtelObservableInstrument>> Instruments;
+};
@@ -0,0 +1,112 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelGcStats.h"
+
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+
+FOtelGcStats::FOtelGcStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	FOtelMeter Meter = Module.GetMeter(TEXT("gc_stats"));
+
+	const double PauseBucketsRaw[] = { 1, 5, 10, 20, 35, 50, 75, 100, 150, 250, 500, 1000 };
+	const FOtelHistogramBuckets PauseBuckets = FOtelHistogramBuckets::From(PauseBucketsRaw);
+
+	HistogramPauseMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("gc_stats_pause"), PauseBuckets, EUnit::Milliseconds);
+	HistogramReachabilityMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("gc_stats_reachability"), PauseBuckets, EUnit::Milliseconds);
+	HistogramPurgeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("gc_stats_purge"), PauseBuckets, EUnit::Milliseconds);
+	CounterCollections = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("gc_stats_collections"));
+	CounterObjectsPurged = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("gc_stats_objects_purged"));
+
+	PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FOtelGcStats::OnPreGarbageCollect);
+	PostReachabilityAnalysisHandle = FCoreUObjectDelegates::PostReachabilityAnalysis.AddRaw(this, &FOtelGcStats::OnPostReachabilityAnalysis);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FOtelGcStats::OnPostGarbageCollect);
+	PostPurgeGarbageHandle = FCoreUObjectDelegates::GetPostPurgeGarbageDelegate().AddRaw(this, &FOtelGcStats::OnPostPurgeGarbage);
+}
+
+FOtelGcStats::~FOtelGcStats()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	FCoreUObjectDelegates::PostReachabilityAnalysis.Remove(PostReachabilityAnalysisHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	FCoreUObjectDelegates::GetPostPurgeGarbageDelegate().Remove(PostPurgeGarbageHandle);
+
+	if (GcSpanId.IsSet())
+	{
+		Module.Unpin(*GcSpanId);
+	}
+}
+
+void FOtelGcStats::OnPreGarbageCollect()
+{
+	bIsCollecting = true;
+	bIsPurgePending = true;
+	GcStartTime = FPlatformTime::Seconds();
+	ReachabilityEndTime = GcStartTime;
+	NumObjectsBeforeGc = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+	// Scoped so the span is parented to the current frame span, if any, but pinned since it ends in another callback
+	FOtelScopedSpan ScopedSpan = OTEL_SPAN(TEXT("GarbageCollect"));
+	const uint64 SpanId = Module.Pin(ScopedSpan);
+	if (SpanId != 0)
+	{
+		GcSpanId = SpanId;
+	}
+}
+
+void FOtelGcStats::OnPostReachabilityAnalysis()
+{
+	if (bIsCollecting)
+	{
+		ReachabilityEndTime = FPlatformTime::Seconds();
+	}
+}
+
+void FOtelGcStats::OnPostGarbageCollect()
+{
+	if (bIsCollecting == false)
+	{
+		return;
+	}
+	bIsCollecting = false;
+
+	const double Now = FPlatformTime::Seconds();
+	const double PauseMs = (Now - GcStartTime) * 1000.0;
+	const double ReachabilityMs = (ReachabilityEndTime - GcStartTime) * 1000.0;
+	const double PurgeMs = (Now - ReachabilityEndTime) * 1000.0;
+
+	// With incremental purging, the remaining objects are destroyed over the next frames and counted once that finishes
+	TArray<FAnalyticsEventAttribute, TInlineAllocator<1>> Attributes;
+	Attributes.Add(FAnalyticsEventAttribute(TEXT("purge"), bIsPurgePending ? TEXT("incremental") : TEXT("full")));
+
+	HistogramPauseMs->Record(PauseMs, Attributes);
+	HistogramReachabilityMs->Record(ReachabilityMs, Attributes);
+	HistogramPurgeMs->Record(PurgeMs, Attributes);
+	CounterCollections->Add(1ull, Attributes);
+
+	if (GcSpanId.IsSet())
+	{
+		FOtelScopedSpan ScopedSpan = Module.Unpin(*GcSpanId);
+		FOtelSpan Span = ScopedSpan.Inner();
+		Span.AddAttribute(FAnalyticsEventAttribute(TEXT("reachability_ms"), ReachabilityMs));
+		Span.AddAttribute(FAnalyticsEventAttribute(TEXT("purge_ms"), PurgeMs));
+		Span.AddAttributes(Attributes);
+
+		GcSpanId.Reset();
+	}
+}
+
+void FOtelGcStats::OnPostPurgeGarbage()
+{
+	if (bIsPurgePending == false)
+	{
+		return;
+	}
+	bIsPurgePending = false;
+
+	// Objects allocated while purging incrementally make this an underestimate, which is fine for spotting trends
+	const int32 NumObjectsAfterPurge = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	const int32 NumObjectsPurged = FMath::Max(0, NumObjectsBeforeGc - NumObjectsAfterPurge);
+	CounterObjectsPurged->Add(static_cast<uint64>(NumObjectsPurged), {});
+}
@@ -0,0 +1,41 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+// Times every garbage collection through the engine's GC delegates. Each collection gets a span under whatever span is
+// currently scoped (e.g. the frame), with the reachability analysis and purge phases as attributes, and the phase
+// durations and number of purged objects are recorded as metrics. All delegates fire on the game thread.
+class FOtelGcStats
+{
+public:
+	FOtelGcStats(FOtelModule& InModule);
+	~FOtelGcStats();
+
+private:
+	void OnPreGarbageCollect();
+	void OnPostReachabilityAnalysis();
+	void OnPostGarbageCollect();
+	void OnPostPurgeGarbage();
+
+	FOtelModule& Module;
+
+	TSharedPtr<FOtelHistogram> HistogramPauseMs;
+	TSharedPtr<FOtelHistogram> HistogramReachabilityMs;
+	TSharedPtr<FOtelHistogram> HistogramPurgeMs;
+	TSharedPtr<FOtelCounter> CounterCollections;
+	TSharedPtr<FOtelCounter> CounterObjectsPurged;
+
+	TOptional<uint64> GcSpanId;
+	double GcStartTime = 0.0;
+	double ReachabilityEndTime = 0.0;
+	int32 NumObjectsBeforeGc = 0;
+	bool bIsCollecting = false;
+	bool bIsPurgePending = false;
+
+	FDelegateHandle PreGarbageCollectHandle;
+	FDelegateHandle PostReachabilityAnalysisHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle PostPurgeGarbageHandle;
+};
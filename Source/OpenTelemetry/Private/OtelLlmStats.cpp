@@ -0,0 +1,105 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelLlmStats.h"
+
+#include "HAL/LowLevelMemTracker.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+// Tags that sum up other tags rather than holding memory of their own. Counting them would push real tags out of the
+// top N and count their memory twice in Other.
+static bool IsSummaryTag(FName TagName)
+{
+	static const FName SummaryTags[] = {
+		TEXT("Total"),
+		TEXT("Untracked"),
+		TEXT("TrackedTotal"),
+		TEXT("UntrackedTotal"),
+		TEXT("PlatformTotal"),
+		TEXT("PlatformTrackedTotal"),
+		TEXT("PlatformUntrackedTotal"),
+		TEXT("PlatformRecoveredTotal"),
+		TEXT("PlatformOSTotal"),
+		TEXT("PlatformOverhead"),
+	};
+
+	for (const FName& SummaryTag : SummaryTags)
+	{
+		if (TagName == SummaryTag)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+#endif
+
+FOtelLlmStats::FOtelLlmStats(FOtelModule& InModule)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	TopTags = InModule.GetConfig().Stats.LlmTopTags;
+	if (TopTags <= 0 || FLowLevelMemTracker::IsEnabled() == false)
+	{
+		return;
+	}
+
+	FOtelMeter Meter = InModule.GetMeter(TEXT("llm_stats"));
+	GaugeTagMemory = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("llm_stats_tag_memory"), [this](FOtelObserver& Observer)
+		{
+			ObserveTags(Observer);
+		},
+		EUnit::Bytes);
+#endif
+}
+
+FOtelLlmStats::~FOtelLlmStats()
+{
+	// Unregister the callback before the buffers it uses go away
+	GaugeTagMemory.Reset();
+}
+
+void FOtelLlmStats::ObserveTags(FOtelObserver& Observer)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	TagAmounts.Reset();
+	FLowLevelMemTracker::Get().GetTrackedTagsNamesWithAmount(TagAmounts, ELLMTracker::Default, ELLMTagSet::None);
+
+	SortedTagAmounts.Reset();
+	for (const TPair<FName, uint64>& Pair : TagAmounts)
+	{
+		if (IsSummaryTag(Pair.Key) == false)
+		{
+			SortedTagAmounts.Add(Pair);
+		}
+	}
+
+	SortedTagAmounts.Sort([](const TPair<FName, uint64>& A, const TPair<FName, uint64>& B)
+		{
+			return A.Value > B.Value;
+		});
+
+	uint64 OtherAmount = 0;
+	for (int32 i = 0; i < SortedTagAmounts.Num(); ++i)
+	{
+		const TPair<FName, uint64>& TagAmount = SortedTagAmounts[i];
+		if (i < TopTags)
+		{
+			const FAnalyticsEventAttribute Attributes[] = {
+				FAnalyticsEventAttribute(TEXT("tag"), TagAmount.Key.ToString()),
+			};
+			Observer.Observe(static_cast<int64>(TagAmount.Value), Attributes);
+		}
+		else
+		{
+			OtherAmount += TagAmount.Value;
+		}
+	}
+
+	if (SortedTagAmounts.Num() > TopTags)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("tag"), TEXT("Other")),
+		};
+		Observer.Observe(static_cast<int64>(OtherAmount), Attributes);
+	}
+#endif
+}
@@ -0,0 +1,25 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+// Reports how much memory each Low Level Memory tracker tag holds. Tag totals are read from the tracker's existing
+// per-tag aggregates when metrics are collected for export, so nothing is added to the allocation path. Only the
+// largest tags are reported individually to bound the number of series. Summary tags like Total are left out.
+class FOtelLlmStats
+{
+public:
+	FOtelLlmStats(FOtelModule& InModule);
+	~FOtelLlmStats();
+
+private:
+	void ObserveTags(FOtelObserver& Observer);
+
+	int32 TopTags = 0;
+	TSharedPtr<FOtelObservableInstrument> GaugeTagMemory;
+
+	// Only accessed from the exporter thread, kept around to avoid reallocating on every collection
+	TMap<FName, uint64> TagAmounts;
+	TArray<TPair<FName, uint64>> SortedTagAmounts;
+};
@@ -0,0 +1,165 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelLoadStats.h"
+
+#include "Misc/CoreDelegates.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+// Loads that never report their end (e.g. failed loads) are dropped rather than accumulating forever
+static constexpr int32 MaxPendingSyncLoads = 256;
+
+// Sync loads can be requested by object path or filename, while the end of the load only has the package
+static FName GetLoadPackageName(const FString& RequestedName)
+{
+	FString PackageName = FPackageName::ObjectPathToPackageName(RequestedName);
+	if (FPackageName::IsValidLongPackageName(PackageName) == false)
+	{
+		FPackageName::TryConvertFilenameToLongPackageName(RequestedName, PackageName);
+	}
+	return FName(*PackageName);
+}
+
+FOtelLoadStats::FOtelLoadStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	const FOtelStatsConfig& Config = Module.GetConfig().Stats;
+	SpanThresholdMs = Config.LoadSpanThresholdMs;
+	SpanThresholdBytes = Config.LoadSpanThresholdBytes;
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("load_stats"));
+
+	const double LoadBucketsRaw[] = { 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000 };
+	const FOtelHistogramBuckets LoadBuckets = FOtelHistogramBuckets::From(LoadBucketsRaw);
+
+	HistogramSyncLoadMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("load_stats_sync_load"), LoadBuckets, EUnit::Milliseconds);
+	CounterSyncLoads = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("load_stats_sync_loads"));
+	CounterDroppedSyncLoads = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("load_stats_sync_loads_dropped"));
+	CounterAsyncLoadingFlushes = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("load_stats_async_loading_flushes"));
+
+	// The number of async packages is a plain counter read, so it's fine to sample from the exporter thread
+	GaugeAsyncPackages = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("load_stats_async_packages"), [](FOtelObserver& Observer)
+		{
+			Observer.Observe(static_cast<int64>(GetNumAsyncPackages()), {});
+		});
+
+	SyncLoadPackageHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddRaw(this, &FOtelLoadStats::OnSyncLoadPackage);
+	EndLoadPackageHandle = FCoreUObjectDelegates::OnEndLoadPackage.AddRaw(this, &FOtelLoadStats::OnEndLoadPackage);
+	AsyncLoadingFlushHandle = FCoreDelegates::OnAsyncLoadingFlush.AddRaw(this, &FOtelLoadStats::OnAsyncLoadingFlush);
+}
+
+FOtelLoadStats::~FOtelLoadStats()
+{
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadPackageHandle);
+	FCoreUObjectDelegates::OnEndLoadPackage.Remove(EndLoadPackageHandle);
+	FCoreDelegates::OnAsyncLoadingFlush.Remove(AsyncLoadingFlushHandle);
+
+	GaugeAsyncPackages.Reset();
+}
+
+void FOtelLoadStats::OnSyncLoadPackage(const FString& PackageName)
+{
+	const FOtelTimestamp Now = FOtelTimestamp::Now();
+	const FName LoadPackageName = GetLoadPackageName(PackageName);
+
+	bool bDropped = false;
+	{
+		FOtelLockedData<TMap<FName, FOtelTimestamp>> Pending = PendingSyncLoads.Lock();
+
+		// Nested loads of the same package are timed from the outermost request
+		if (Pending->Contains(LoadPackageName))
+		{
+			return;
+		}
+
+		// The oldest load is the one least likely to still finish
+		if (Pending->Num() >= MaxPendingSyncLoads)
+		{
+			FName OldestName;
+			int64 OldestSteady = MAX_int64;
+			for (const TPair<FName, FOtelTimestamp>& Pair : *Pending)
+			{
+				if (Pair.Value.Steady < OldestSteady)
+				{
+					OldestName = Pair.Key;
+					OldestSteady = Pair.Value.Steady;
+				}
+			}
+			Pending->Remove(OldestName);
+			bDropped = true;
+		}
+
+		Pending->Add(LoadPackageName, Now);
+	}
+
+	if (bDropped)
+	{
+		CounterDroppedSyncLoads->Add(1ull, {});
+	}
+}
+
+void FOtelLoadStats::OnEndLoadPackage(const FEndLoadPackageContext& Context)
+{
+	struct FFinishedLoad
+	{
+		UPackage* Package;
+		FOtelTimestamp Start;
+	};
+
+	TArray<FFinishedLoad, TInlineAllocator<8>> FinishedLoads;
+	{
+		FOtelLockedData<TMap<FName, FOtelTimestamp>> Pending = PendingSyncLoads.Lock();
+		if (Pending->IsEmpty())
+		{
+			return;
+		}
+
+		for (UPackage* Package : Context.LoadedPackages)
+		{
+			FOtelTimestamp Start;
+			if (Package && Pending->RemoveAndCopyValue(Package->GetFName(), Start))
+			{
+				FinishedLoads.Add({ Package, Start });
+			}
+		}
+	}
+
+	const FOtelTimestamp Now = FOtelTimestamp::Now();
+	for (FFinishedLoad& Load : FinishedLoads)
+	{
+		const double DurationMs = static_cast<double>(Now.Steady - Load.Start.Steady) / 1000000.0;
+		HistogramSyncLoadMs->Record(DurationMs, {});
+		CounterSyncLoads->Add(1ull, {});
+
+		int64 SizeBytes = 0;
+#if WITH_EDITORONLY_DATA
+		SizeBytes = Load.Package->GetFileSize();
+#endif
+
+		const bool bIsSlow = DurationMs >= SpanThresholdMs;
+		const bool bIsLarge = (SpanThresholdBytes > 0) && (SizeBytes >= SpanThresholdBytes);
+		if (bIsSlow || bIsLarge)
+		{
+			TArray<FAnalyticsEventAttribute, TInlineAllocator<2>> Attributes;
+			Attributes.Add(FAnalyticsEventAttribute(TEXT("package"), Load.Package->GetName()));
+			if (SizeBytes > 0)
+			{
+				Attributes.Add(FAnalyticsEventAttribute(TEXT("size_bytes"), SizeBytes));
+			}
+
+			// Started retroactively and ended immediately, so only sampled loads pay for a span
+			FOtelScopedSpan ScopedSpan = Module.GetTracer().StartSpanScopedOpts(TEXT("SyncLoadPackage"), TEXT(__FILE__), __LINE__, Attributes, &Load.Start);
+		}
+	}
+}
+
+void FOtelLoadStats::OnAsyncLoadingFlush()
+{
+	// Broadcast as a flush starts. Flushes with nothing in flight return right away, and many engine paths flush
+	// defensively, so only the ones that have packages to wait on are counted.
+	if (GetNumAsyncPackages() > 0)
+	{
+		CounterAsyncLoadingFlushes->Add(1ull, {});
+	}
+}
@@ -0,0 +1,41 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+struct FEndLoadPackageContext;
+
+// Tracks blocking package loads in all build configurations. Every synchronous load is timed from the engine's sync
+// load notification until the package shows up in an end-of-load notification and recorded in a histogram. Loads over
+// the configured duration (or, with editor-only data, size) threshold also get a span under the currently scoped span.
+// Async loading flushes that have packages to wait on are counted and the async loading queue depth is reported as a gauge. Pending sync loads are
+// capped, and the oldest one is dropped and counted when a new load would go past the cap.
+class FOtelLoadStats
+{
+public:
+	FOtelLoadStats(FOtelModule& InModule);
+	~FOtelLoadStats();
+
+private:
+	void OnSyncLoadPackage(const FString& PackageName);
+	void OnEndLoadPackage(const FEndLoadPackageContext& Context);
+	void OnAsyncLoadingFlush();
+
+	FOtelModule& Module;
+	double SpanThresholdMs = 0.0;
+	int64 SpanThresholdBytes = 0;
+
+	TSharedPtr<FOtelHistogram> HistogramSyncLoadMs;
+	TSharedPtr<FOtelCounter> CounterSyncLoads;
+	TSharedPtr<FOtelCounter> CounterDroppedSyncLoads;
+	TSharedPtr<FOtelCounter> CounterAsyncLoadingFlushes;
+	TSharedPtr<FOtelObservableInstrument> GaugeAsyncPackages;
+
+	// Sync loads can be requested from any thread, but usually end on the game thread
+	FOtelUnlockedData<TMap<FName, FOtelTimestamp>> PendingSyncLoads;
+
+	FDelegateHandle SyncLoadPackageHandle;
+	FDelegateHandle EndLoadPackageHandle;
+	FDelegateHandle AsyncLoadingFlushHandle;
+};
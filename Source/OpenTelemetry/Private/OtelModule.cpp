@@ -1,7 +1,24 @@
 // Copyright The Believer Company. All Rights Reserved.
 
 #include "Otel.h"
+#include "OtelBudget.h"
+#include "OtelCollectorScheduler.h"
+#include "OtelCommandletTracing.h"
+#include "OtelCsvStats.h"
+#include "OtelEngineStats.h"
+#include "OtelFramePacing.h"
+#include "OtelGcStats.h"
+#include "OtelLlmStats.h"
+#include "OtelLoadStats.h"
+#include "OtelModuleLoadStats.h"
+#include "OtelNetStats.h"
+#include "OtelOverhead.h"
+#include "OtelProcStats.h"
+#include "OtelReplicationStats.h"
+#include "OtelServerNetStats.h"
 #include "OtelStats.h"
+#include "OtelTaskStats.h"
+#include "OtelWorldTracker.h"
 
 #include "AnalyticsEventAttribute.h"
 #include "Misc/Base64.h"
@@ -100,6 +117,8 @@ public:
 
 	bool ForEachKeyValue(otel::nostd::function_ref<bool(otel::nostd::string_view, otel::common::AttributeValue)> Callback) const noexcept
 	{
+		OTEL_OVERHEAD_SCOPE(AttributeConversion);
+
 		for (const FAnalyticsEventAttribute& Attribute : Attributes)
 		{
 			auto Name = StringCast<ANSICHAR>(*Attribute.GetName());
@@ -242,8 +261,14 @@ void FOtelSpan::AddEvent(const TCHAR* Name, TArrayView<const FAnalyticsEventAttr
 {
 	check(Name);
 
-	if (OtelSpan)
+	if (OtelSpan && OtelSpan->IsRecording())
 	{
+		FOtelModule* Module = FOtelModule::TryGet();
+		if (Module && Module->BudgetState && Module->BudgetState->ShouldCaptureEvent() == false)
+		{
+			return;
+		}
+
 		EventAttributesOtelConverter AttributeConverter(Attributes);
 
 		auto NameAnsi = StringCast<ANSICHAR>(Name);
@@ -251,6 +276,31 @@ void FOtelSpan::AddEvent(const TCHAR* Name, TArrayView<const FAnalyticsEventAttr
 	}
 }
 
+void FOtelSpan::End(const FOtelTimestamp* OptionalTimestamp)
+{
+	if (OtelSpan)
+	{
+		OTEL_OVERHEAD_SCOPE(SpanEnd);
+
+		otel::trace::EndSpanOptions EndOptions;
+		if (OptionalTimestamp)
+		{
+			EndOptions.end_steady_time = ToBridgeTimestamp(*OptionalTimestamp).Steady;
+		}
+		OtelSpan->End(EndOptions);
+	}
+}
+
+FOtelSpan::~FOtelSpan()
+{
+	// Releasing the last reference to a span that's still recording ends it, which costs as much as End()
+	if (OtelSpan && OtelSpan.use_count() == 1 && OtelSpan->IsRecording())
+	{
+		OTEL_OVERHEAD_SCOPE(SpanEnd);
+		OtelSpan.reset();
+	}
+}
+
 FString FOtelSpan::TraceId() const
 {
 	if (OtelSpan)
@@ -336,6 +386,8 @@ FOtelScopedSpan::~FOtelScopedSpan()
 		--Scope->RefCount;
 		if (Scope->RefCount <= 0)
 		{
+			OTEL_OVERHEAD_SCOPE(SpanEnd);
+
 			// Destroy scoped span
 			if (FOtelModule* Module = FOtelModule::TryGet())
 			{
@@ -395,6 +447,7 @@ FOtelSpan FOtelTracer::StartSpan(const TCHAR* SpanName, const TCHAR* File, int32
 FOtelSpan FOtelTracer::StartSpanOpts(const TCHAR* SpanName, const TCHAR* File, int32 LineNumber, const FOtelSpan* OptionalParentSpan, TArrayView<const FAnalyticsEventAttribute> Attributes, FOtelTimestamp* OptionalTimestamp)
 {
 	check(SpanName);
+	OTEL_OVERHEAD_SCOPE(SpanStart);
 
 	if (OtelTracer)
 	{
@@ -433,6 +486,7 @@ FOtelScopedSpan FOtelTracer::StartSpanScoped(const TCHAR* SpanName, const TCHAR*
 FOtelScopedSpan FOtelTracer::StartSpanScopedOpts(const TCHAR* SpanName, const TCHAR* File, int32 LineNumber, TArrayView<const FAnalyticsEventAttribute> Attributes, FOtelTimestamp* OptionalTimestamp)
 {
 	check(SpanName);
+	OTEL_OVERHEAD_SCOPE(SpanStart);
 
 	FOtelModule& Module = FOtelModule::Get();
 	FOtelLockedData<FOtelModule::FTracerToScopeStack> TracerToScopeStack = Module.LockedTracerToScopeStack.Lock();
@@ -463,6 +517,7 @@ struct FOtelCounterUInt64 : public FOtelCounter
 {
 	virtual void Add(uint64 Value, TArrayView<FAnalyticsEventAttribute> Attributes) override
 	{
+		OTEL_OVERHEAD_SCOPE(InstrumentRecord);
 		EventAttributesOtelConverter AttributeIterable = EventAttributesOtelConverter(Attributes);
 		OtelCounter->Add(static_cast<uint64_t>(Value), AttributeIterable, otel::context::Context());
 	}
@@ -486,6 +541,7 @@ struct FOtelCounterDouble : public FOtelCounter
 	{
 		if (ensure(Value >= 0.0))
 		{
+			OTEL_OVERHEAD_SCOPE(InstrumentRecord);
 			EventAttributesOtelConverter AttributeIterable = EventAttributesOtelConverter(Attributes);
 			OtelCounter->Add(Value, AttributeIterable, otel::context::Context());
 		}
@@ -516,16 +572,138 @@ struct FOtelCounterNoop : public FOtelCounter
 };
 
 template <typename T>
-struct TOtelGauge : public FOtelGauge
+struct TOtelObserver : public FOtelObserver
 {
-	inline void ObserveInternal(T Value, TArrayView<FAnalyticsEventAttribute> Attributes)
+	TOtelObserver(otel::metrics::ObserverResultT<T>& InResult)
+		: Result(InResult)
+	{
+	}
+
+	virtual void Observe(int64 Value, TArrayView<const FAnalyticsEventAttribute> Attributes) override
+	{
+		if constexpr (std::is_same_v<int64_t, T>)
+		{
+			Result.Observe(Value, EventAttributesOtelConverter(Attributes));
+		}
+		else
+		{
+			UE_LOG(LogOtel, Warning, TEXT("Observing int64 value on instrument that is configured for double - value will be dropped."));
+		}
+	}
+
+	virtual void Observe(double Value, TArrayView<const FAnalyticsEventAttribute> Attributes) override
+	{
+		if constexpr (std::is_same_v<double, T>)
+		{
+			Result.Observe(Value, EventAttributesOtelConverter(Attributes));
+		}
+		else
+		{
+			UE_LOG(LogOtel, Warning, TEXT("Observing double value on instrument that is configured for int64 - value will be dropped."));
+		}
+	}
+
+	otel::metrics::ObserverResultT<T>& Result;
+};
+
+template <typename T>
+struct TOtelObservableInstrument : public FOtelObservableInstrument
+{
+	TOtelObservableInstrument(FOtelObserveCallback&& InCallback)
+		: Callback(MoveTemp(InCallback))
 	{
-		if (LastObserved.IsValid() == false)
+	}
+
+	virtual ~TOtelObservableInstrument() override
+	{
+		// The otel libs hold their callback lock while collecting, so once this returns the callback can no longer be
+		// running on the exporter thread
+		if (OtelInstrument)
 		{
-			LastObserved = MakeUnique<std::atomic<T>>();
+			OtelInstrument->RemoveCallback(&OtelCallback, this);
 		}
-		*LastObserved = Value;
-		LastAttributes = Attributes;
+	}
+
+	void SetInstrument(std::shared_ptr<otel::metrics::ObservableInstrument> InOtelInstrument)
+	{
+		check(OtelInstrument == nullptr);
+		OtelInstrument = InOtelInstrument;
+		OtelInstrument->AddCallback(&OtelCallback, this);
+	}
+
+	static void OtelCallback(otel::metrics::ObserverResult Result, void* ThisInstrument)
+	{
+		TOtelObservableInstrument<T>* This = static_cast<TOtelObservableInstrument<T>*>(ThisInstrument);
+
+		auto TypedResult = std::get<otel::nostd::shared_ptr<otel::metrics::ObserverResultT<T>>>(Result);
+		TOtelObserver<T> Observer(*TypedResult);
+		This->Callback(Observer);
+	}
+
+	FOtelObserveCallback Callback;
+	std::shared_ptr<otel::metrics::ObservableInstrument> OtelInstrument;
+};
+
+enum class EOtelObservableKind
+{
+	Gauge,
+	Counter,
+};
+
+static TSharedPtr<FOtelObservableInstrument> CreateObservableInstrument(otel::metrics::Meter* OtelMeter, EOtelObservableKind Kind, EOtelInstrumentType MeterType, const TCHAR* InstrumentName, FOtelObserveCallback&& Callback, EUnit UnitType)
+{
+	check(InstrumentName);
+	check(Callback);
+	auto InstrumentNameAnsi = StringCast<ANSICHAR>(InstrumentName);
+
+	const TCHAR* UnitTypeStr = (UnitType != EUnit::Unspecified) ? FUnitConversion::GetUnitDisplayString(UnitType) : TEXT("");
+	auto UnitTypeStrAnsi = StringCast<ANSICHAR>(UnitTypeStr);
+
+	TSharedPtr<FOtelObservableInstrument> Instrument;
+	if (OtelMeter)
+	{
+		if (MeterType == EOtelInstrumentType::Int64)
+		{
+			TSharedPtr<TOtelObservableInstrument<int64_t>> Int64Instrument = MakeShared<TOtelObservableInstrument<int64_t>>(MoveTemp(Callback));
+			Int64Instrument->SetInstrument((Kind == EOtelObservableKind::Gauge)
+					? OtelMeter->CreateInt64ObservableGauge(InstrumentNameAnsi.Get(), "", UnitTypeStrAnsi.Get())
+					: OtelMeter->CreateInt64ObservableCounter(InstrumentNameAnsi.Get(), "", UnitTypeStrAnsi.Get()));
+			Instrument = Int64Instrument;
+		}
+		else
+		{
+			TSharedPtr<TOtelObservableInstrument<double>> DoubleInstrument = MakeShared<TOtelObservableInstrument<double>>(MoveTemp(Callback));
+			DoubleInstrument->SetInstrument((Kind == EOtelObservableKind::Gauge)
+					? OtelMeter->CreateDoubleObservableGauge(InstrumentNameAnsi.Get(), "", UnitTypeStrAnsi.Get())
+					: OtelMeter->CreateDoubleObservableCounter(InstrumentNameAnsi.Get(), "", UnitTypeStrAnsi.Get()));
+			Instrument = DoubleInstrument;
+		}
+	}
+	else
+	{
+		Instrument = MakeShared<FOtelObservableInstrument>();
+	}
+
+	return Instrument;
+}
+
+// Push-style gauge built on top of an observable instrument: the last observed value is cached until the exporter
+// collects it.
+template <typename T>
+struct TOtelGauge : public FOtelGauge
+{
+	virtual ~TOtelGauge() override
+	{
+		// Unregister before the cached value goes away, since the exporter thread may be reading it
+		Instrument.Reset();
+	}
+
+	inline void ObserveInternal(T Value, TArrayView<FAnalyticsEventAttribute> Attributes)
+	{
+		FOtelLockedData<FLastObserved> Observed = LastObserved.Lock();
+		Observed->Value = Value;
+		Observed->Attributes = Attributes;
+		Observed->bIsSet = true;
 	}
 
 	virtual void Observe(int64 Value, TArrayView<FAnalyticsEventAttribute> Attributes) override
@@ -536,7 +714,7 @@ struct TOtelGauge : public FOtelGauge
 		}
 		else
 		{
-			UE_LOG(LogOtel, Warning, TEXT("Adding double value on Gauge that is configured for uint64 - value will be dropped."));
+			UE_LOG(LogOtel, Warning, TEXT("Adding int64 value on Gauge that is configured for double - value will be dropped."));
 		}
 	}
 
@@ -548,32 +726,35 @@ struct TOtelGauge : public FOtelGauge
 		}
 		else
 		{
-			UE_LOG(LogOtel, Warning, TEXT("Adding double value on Gauge that is configured for uint64 - value will be dropped."));
+			UE_LOG(LogOtel, Warning, TEXT("Adding double value on Gauge that is configured for int64 - value will be dropped."));
 		}
 	}
 
-	void SetGauge(std::shared_ptr<otel::metrics::ObservableInstrument> InOtelGauge)
+	void ObserveLast(FOtelObserver& Observer)
 	{
-		check(OtelGauge == nullptr);
-		OtelGauge = InOtelGauge;
-		OtelGauge->AddCallback(&OtelCallback, this);
-	}
-
-	static void OtelCallback(otel::metrics::ObserverResult Result, void* ThisGauge)
-	{
-		TOtelGauge<T>* This = static_cast<TOtelGauge<T>*>(ThisGauge);
-		if (const std::atomic<T>* Value = This->LastObserved.Get())
+		FOtelLockedData<FLastObserved> Observed = LastObserved.Lock();
+		if (Observed->bIsSet)
 		{
-			EventAttributesOtelConverter AttributeIterable = EventAttributesOtelConverter(This->LastAttributes);
-
-			auto TypedResult = std::get<otel::nostd::shared_ptr<otel::metrics::ObserverResultT<T>>>(Result);
-			TypedResult->Observe(Value->load(), AttributeIterable);
+			if constexpr (std::is_same_v<int64_t, T>)
+			{
+				Observer.Observe(static_cast<int64>(Observed->Value), Observed->Attributes);
+			}
+			else
+			{
+				Observer.Observe(Observed->Value, Observed->Attributes);
+			}
 		}
 	}
 
-	std::shared_ptr<otel::metrics::ObservableInstrument> OtelGauge;
-	TUniquePtr<std::atomic<T>> LastObserved;
-	TArray<FAnalyticsEventAttribute> LastAttributes;
+	struct FLastObserved
+	{
+		T Value = 0;
+		TArray<FAnalyticsEventAttribute> Attributes;
+		bool bIsSet = false;
+	};
+
+	FOtelUnlockedData<FLastObserved> LastObserved;
+	TSharedPtr<FOtelObservableInstrument> Instrument;
 };
 
 struct FOtelGaugeNoop : public FOtelGauge
@@ -600,6 +781,7 @@ struct FOtelHistogramUInt64 : public FOtelHistogram
 {
 	virtual void Record(uint64 Value, TArrayView<FAnalyticsEventAttribute> Attributes) override
 	{
+		OTEL_OVERHEAD_SCOPE(InstrumentRecord);
 		EventAttributesOtelConverter AttributeIterable = EventAttributesOtelConverter(Attributes);
 		OtelHistogram->Record(static_cast<uint64_t>(Value), AttributeIterable, otel::context::Context());
 	}
@@ -623,6 +805,7 @@ struct FOtelHistogramDouble : public FOtelHistogram
 	{
 		if (ensure(Value >= 0.0))
 		{
+			OTEL_OVERHEAD_SCOPE(InstrumentRecord);
 			EventAttributesOtelConverter AttributeIterable = EventAttributesOtelConverter(Attributes);
 			OtelHistogram->Record(Value, AttributeIterable, otel::context::Context());
 		}
@@ -707,24 +890,28 @@ TSharedPtr<FOtelCounter> FOtelMeter::CreateCounter(EOtelInstrumentType MeterType
 
 TSharedPtr<FOtelGauge> FOtelMeter::CreateGauge(EOtelInstrumentType MeterType, const TCHAR* GaugeName, EUnit UnitType)
 {
-	auto GaugeNameAnsi = StringCast<ANSICHAR>(GaugeName);
-
-	const TCHAR* UnitTypeStr = (UnitType != EUnit::Unspecified) ? FUnitConversion::GetUnitDisplayString(UnitType) : TEXT("");
-	auto UnitTypeStrAnsi = StringCast<ANSICHAR>(UnitTypeStr);
-
 	TSharedPtr<FOtelGauge> Gauge;
 	if (OtelMeter)
 	{
+		// The instrument is owned by the gauge and unregistered in its destructor, so the raw pointer can't dangle
 		if (MeterType == EOtelInstrumentType::Int64)
 		{
-			TSharedPtr<TOtelGauge<int64_t>> UInt64Gauge = MakeShared<TOtelGauge<int64_t>>();
-			UInt64Gauge->SetGauge(OtelMeter->CreateInt64ObservableGauge(GaugeNameAnsi.Get(), "", UnitTypeStrAnsi.Get()));
-			Gauge = UInt64Gauge;
+			TSharedPtr<TOtelGauge<int64_t>> Int64Gauge = MakeShared<TOtelGauge<int64_t>>();
+			Int64Gauge->Instrument = CreateObservableInstrument(OtelMeter.get(), EOtelObservableKind::Gauge, MeterType, GaugeName, [Int64GaugePtr = Int64Gauge.Get()](FOtelObserver& Observer)
+				{
+					Int64GaugePtr->ObserveLast(Observer);
+				},
+				UnitType);
+			Gauge = Int64Gauge;
 		}
 		else
 		{
 			TSharedPtr<TOtelGauge<double>> DoubleGauge = MakeShared<TOtelGauge<double>>();
-			DoubleGauge->SetGauge(OtelMeter->CreateDoubleObservableGauge(GaugeNameAnsi.Get(), "", UnitTypeStrAnsi.Get()));
+			DoubleGauge->Instrument = CreateObservableInstrument(OtelMeter.get(), EOtelObservableKind::Gauge, MeterType, GaugeName, [DoubleGaugePtr = DoubleGauge.Get()](FOtelObserver& Observer)
+				{
+					DoubleGaugePtr->ObserveLast(Observer);
+				},
+				UnitType);
 			Gauge = DoubleGauge;
 		}
 	}
@@ -736,6 +923,16 @@ TSharedPtr<FOtelGauge> FOtelMeter::CreateGauge(EOtelInstrumentType MeterType, co
 	return Gauge;
 }
 
+TSharedPtr<FOtelObservableInstrument> FOtelMeter::CreateObservableCounter(EOtelInstrumentType MeterType, const TCHAR* CounterName, FOtelObserveCallback Callback, EUnit UnitType)
+{
+	return CreateObservableInstrument(OtelMeter.get(), EOtelObservableKind::Counter, MeterType, CounterName, MoveTemp(Callback), UnitType);
+}
+
+TSharedPtr<FOtelObservableInstrument> FOtelMeter::CreateObservableGauge(EOtelInstrumentType MeterType, const TCHAR* GaugeName, FOtelObserveCallback Callback, EUnit UnitType)
+{
+	return CreateObservableInstrument(OtelMeter.get(), EOtelObservableKind::Gauge, MeterType, GaugeName, MoveTemp(Callback), UnitType);
+}
+
 TSharedPtr<FOtelHistogram> FOtelMeter::CreateHistogram(EOtelInstrumentType MeterType, const TCHAR* HistogramName, FOtelHistogramBuckets Buckets, EUnit UnitType)
 {
 #if !PLATFORM_APPLE
@@ -918,6 +1115,63 @@ FOtelConfig FOtelConfig::LoadFromIni()
 		UE_LOG(LogOtel, Display, TEXT("No EndpointUrl found for DefaultOtel.ini section %s. All logs will be dropped."), *LogSectionName);
 	}
 
+	// stats
+
+	const FString StatsSectionName = FString::Printf(TEXT("%s.Stats"), TargetName);
+	ConfigFile.GetArray(*StatsSectionName, TEXT("CsvCategories"), Config.Stats.CsvCategories);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("CsvCaptureFrames"), Config.Stats.CsvCaptureFrames);
+	ConfigFile.GetArray(*StatsSectionName, TEXT("EngineStats"), Config.Stats.EngineStats);
+	ConfigFile.GetArray(*StatsSectionName, TEXT("EngineStatGroups"), Config.Stats.EngineStatGroups);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("LlmTopTags"), Config.Stats.LlmTopTags);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("LoadSpanThresholdMs"), Config.Stats.LoadSpanThresholdMs);
+	ConfigFile.GetInt64(*StatsSectionName, TEXT("LoadSpanThresholdBytes"), Config.Stats.LoadSpanThresholdBytes);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("ReplicationTopClasses"), Config.Stats.ReplicationTopClasses);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("ReplicationMaxRecordsPerFrame"), Config.Stats.ReplicationMaxRecordsPerFrame);
+	ConfigFile.GetFloat(*StatsSectionName, TEXT("FrameBudgetMs"), Config.Stats.FrameBudgetMs);
+	ConfigFile.GetArray(*StatsSectionName, TEXT("StutterThresholdsMs"), Config.Stats.StutterThresholdsMs);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("ModuleLoadSpanThresholdMs"), Config.Stats.ModuleLoadSpanThresholdMs);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("CookPackageSpanThresholdMs"), Config.Stats.CookPackageSpanThresholdMs);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("CookMaxPackageSpans"), Config.Stats.CookMaxPackageSpans);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("EditorAssetSpanThresholdMs"), Config.Stats.EditorAssetSpanThresholdMs);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("EditorHitchThresholdMs"), Config.Stats.EditorHitchThresholdMs);
+	ConfigFile.GetInt(*StatsSectionName, TEXT("SlowTaskSpanThresholdMs"), Config.Stats.SlowTaskSpanThresholdMs);
+
+	const FString CollectorsSectionName = FString::Printf(TEXT("%s.Collectors"), TargetName);
+	ConfigFile.GetInt(*CollectorsSectionName, TEXT("MaxCollectionsPerFrame"), Config.Collectors.MaxCollectionsPerFrame);
+	if (const FConfigSection* CollectorsSection = ConfigFile.FindSection(CollectorsSectionName))
+	{
+		// Per-collector overrides are keyed as <CollectorName>.<Setting>
+		for (const TPair<FName, FConfigValue>& Pair : *CollectorsSection)
+		{
+			FString CollectorName;
+			FString SettingName;
+			if (Pair.Key.ToString().Split(TEXT("."), &CollectorName, &SettingName) == false)
+			{
+				continue;
+			}
+
+			FOtelCollectorConfig& CollectorConfig = Config.Collectors.Overrides.FindOrAdd(FName(*CollectorName));
+			const FString& Value = Pair.Value.GetValue();
+			if (SettingName == TEXT("bEnabled"))
+			{
+				CollectorConfig.bEnabled = FCString::ToBool(*Value);
+			}
+			else if (SettingName == TEXT("IntervalMs"))
+			{
+				CollectorConfig.IntervalMs = FCString::Atoi(*Value);
+			}
+			else
+			{
+				UE_LOG(LogOtel, Warning, TEXT("Unknown collector setting %s in %s."), *Pair.Key.ToString(), *CollectorsSectionName);
+			}
+		}
+	}
+
+	const FString BudgetSectionName = FString::Printf(TEXT("%s.Budget"), TargetName);
+	ConfigFile.GetFloat(*BudgetSectionName, TEXT("FrameBudgetMs"), Config.Budget.FrameBudgetMs);
+	ConfigFile.GetFloat(*BudgetSectionName, TEXT("MaxQueueFill"), Config.Budget.MaxQueueFill);
+	ConfigFile.GetFloat(*BudgetSectionName, TEXT("MinRate"), Config.Budget.MinRate);
+
 	return Config;
 }
 
@@ -981,6 +1235,8 @@ void FOtelOutputDevice::Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity,
 		return;
 	}
 
+	OTEL_OVERHEAD_SCOPE(LogSerialize);
+
 	FOtelLockedData<FLogRoutingData> LockedRouting = TracerLogging.Lock();
 	for (const TPair<FName, FTracerRouting>& Pair : *LockedRouting)
 	{
@@ -1115,6 +1371,11 @@ void FOtelModule::StartupModule()
 #endif // !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 	}
 
+	if (Config.Budget.FrameBudgetMs > 0.0f || Config.Budget.MaxQueueFill > 0.0f)
+	{
+		BudgetState = MakeShared<FOtelBudgetState>();
+	}
+
 	if (Config.Trace.EndpointUrl.IsEmpty() == false && bUseRealBackend)
 	{
 		otel::sdk::resource::ResourceAttributes ResourceAttributes = SharedResAttributes;
@@ -1132,9 +1393,18 @@ void FOtelModule::StartupModule()
 		auto Exporter = otel::exporter::otlp::OtlpGrpcExporterFactory::Create(ExporterOpts);
 
 		otel::sdk::trace::BatchSpanProcessorOptions ProcessorOpts;
-		auto Processor = otel::sdk::trace::BatchSpanProcessorFactory::Create(MoveTemp(Exporter), ProcessorOpts);
 
-		std::shared_ptr<otel::trace::TracerProvider> Provider = otel::sdk::trace::TracerProviderFactory::Create(MoveTemp(Processor), Resource);
+		std::shared_ptr<otel::trace::TracerProvider> Provider;
+		if (BudgetState)
+		{
+			auto Processor = BudgetState->CreateSpanProcessor(MoveTemp(Exporter), ProcessorOpts);
+			Provider = otel::sdk::trace::TracerProviderFactory::Create(MoveTemp(Processor), Resource, BudgetState->CreateSampler());
+		}
+		else
+		{
+			auto Processor = otel::sdk::trace::BatchSpanProcessorFactory::Create(MoveTemp(Exporter), ProcessorOpts);
+			Provider = otel::sdk::trace::TracerProviderFactory::Create(MoveTemp(Processor), Resource);
+		}
 		otel::trace::Provider::SetTracerProvider(Provider);
 	}
 
@@ -1188,21 +1458,82 @@ void FOtelModule::StartupModule()
 
 		// TODO make processor opts configurable via .ini
 		otel::sdk::logs::BatchLogRecordProcessorOptions ProcessorOpts;
-		std::unique_ptr<otel::sdk::logs::LogRecordProcessor> Processor = otel::sdk::logs::BatchLogRecordProcessorFactory::Create(MoveTemp(Exporter), ProcessorOpts);
+		std::unique_ptr<otel::sdk::logs::LogRecordProcessor> Processor = BudgetState
+			? BudgetState->CreateLogProcessor(MoveTemp(Exporter), ProcessorOpts)
+			: otel::sdk::logs::BatchLogRecordProcessorFactory::Create(MoveTemp(Exporter), ProcessorOpts);
 
 		LoggerProvider = otel::sdk::logs::LoggerProviderFactory::Create(MoveTemp(Processor), Resource);
 		otel::logs::Provider::SetLoggerProvider(LoggerProvider);
 	}
 #endif // !PLATFORM_APPLE
 
-	FrameStats = new FOtelStats(*this);
+	Overhead = new FOtelOverhead(*this);
+	CollectorScheduler = new FOtelCollectorScheduler(Config.Collectors);
+	if (BudgetState)
+	{
+		Budget = new FOtelBudget(*this, BudgetState.ToSharedRef());
+	}
+	WorldTracker = new FOtelWorldTracker();
+	FrameStats = new FOtelStats(*this, *WorldTracker);
+	NetStats = new FOtelNetStats(*this, *WorldTracker);
+	FramePacing = new FOtelFramePacing(*this, *WorldTracker);
+	CsvStats = new FOtelCsvStats(*this);
+	EngineStats = new FOtelEngineStats(*this);
+	LlmStats = new FOtelLlmStats(*this);
+	ProcStats = new FOtelProcStats(*this);
+	TaskStats = new FOtelTaskStats(*this, *ProcStats);
+	GcStats = new FOtelGcStats(*this);
+	LoadStats = new FOtelLoadStats(*this);
+	ServerNetStats = new FOtelServerNetStats(*this, *WorldTracker);
+	if (Config.Stats.ReplicationTopClasses > 0)
+	{
+		ReplicationStats = new FOtelReplicationStats(*this);
+	}
+	ModuleLoadStats = new FOtelModuleLoadStats(*this);
+	CommandletTracing = new FOtelCommandletTracing(*this);
 }
 
 void FOtelModule::ShutdownModule()
 {
-#if !PLATFORM_APPLE
+	// Collectors are created on every platform, even where there's no exporter to send their data to
+	delete CommandletTracing;
+	CommandletTracing = nullptr;
+	delete ModuleLoadStats;
+	ModuleLoadStats = nullptr;
+	delete ReplicationStats;
+	ReplicationStats = nullptr;
+	delete ServerNetStats;
+	ServerNetStats = nullptr;
+	delete LoadStats;
+	LoadStats = nullptr;
+	delete GcStats;
+	GcStats = nullptr;
+	delete TaskStats;
+	TaskStats = nullptr;
+	delete ProcStats;
+	ProcStats = nullptr;
+	delete LlmStats;
+	LlmStats = nullptr;
+	delete EngineStats;
+	EngineStats = nullptr;
+	delete CsvStats;
+	CsvStats = nullptr;
+	delete FramePacing;
+	FramePacing = nullptr;
+	delete NetStats;
+	NetStats = nullptr;
 	delete FrameStats;
 	FrameStats = nullptr;
+	delete WorldTracker;
+	WorldTracker = nullptr;
+	delete Budget;
+	Budget = nullptr;
+	delete CollectorScheduler;
+	CollectorScheduler = nullptr;
+	delete Overhead;
+	Overhead = nullptr;
+
+#if !PLATFORM_APPLE
 	MeterProvider = nullptr;
 	LoggerProvider = nullptr;
 
@@ -1309,6 +1640,13 @@ void FOtelModule::EmitLog(const TCHAR* Message, TArrayView<const FAnalyticsEvent
 {
 #if !PLATFORM_APPLE
 	check(Message);
+	OTEL_OVERHEAD_SCOPE(EmitLog);
+
+	const bool bIsError = Status.IsSet() && *Status == EOtelStatus::Error;
+	if (BudgetState && bIsError == false && BudgetState->ShouldRouteLog() == false)
+	{
+		return;
+	}
 
 	otel::trace::SpanId SpanId;
 	otel::trace::TraceId TraceId;
@@ -1337,7 +1675,7 @@ void FOtelModule::EmitLog(const TCHAR* Message, TArrayView<const FAnalyticsEvent
 
 	if (LoggerProvider)
 	{
-		const auto Severity = (Status.IsSet() && *Status == EOtelStatus::Error) ? otel::logs::Severity::kError : otel::logs::Severity::kInfo;
+		const auto Severity = bIsError ? otel::logs::Severity::kError : otel::logs::Severity::kInfo;
 
 		auto TracerNameAnsi = StringCast<ANSICHAR>(*TracerName.ToString());
 
@@ -1385,3 +1723,40 @@ void FOtelModule::ForceFlush(double TimeoutSeconds, const FName TracerName)
 	auto Timeout = std::chrono::milliseconds(static_cast<uint32>(1000 * TimeoutSeconds));
 	Tracer.OtelTracer->ForceFlush(Timeout);
 }
+
+void FOtelModule::RegisterCollector(IOtelCollector* Collector)
+{
+	if (CollectorScheduler)
+	{
+		CollectorScheduler->Register(Collector);
+	}
+}
+
+void FOtelModule::UnregisterCollector(IOtelCollector* Collector)
+{
+	if (CollectorScheduler)
+	{
+		CollectorScheduler->Unregister(Collector);
+	}
+}
+
+FOtelSpan FOtelModule::GetCommandletSpan() const
+{
+	return CommandletTracing ? CommandletTracing->GetCommandletSpan() : FOtelSpan();
+}
+
+void FOtelModule::SetCommandletExitCode(int32 ExitCode)
+{
+	if (CommandletTracing)
+	{
+		CommandletTracing->SetExitCode(ExitCode);
+	}
+}
+
+void FOtelModule::RecordReplication(const UClass* ActorClass, uint32 NumBytes, uint32 CompareCycles)
+{
+	if (ReplicationStats)
+	{
+		ReplicationStats->Record(ActorClass, NumBytes, CompareCycles);
+	}
+}
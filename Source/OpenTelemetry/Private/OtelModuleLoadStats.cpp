@@ -0,0 +1,115 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelModuleLoadStats.h"
+
+#include "Interfaces/IPluginManager.h"
+
+FOtelModuleLoadStats::FOtelModuleLoadStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	SpanThresholdMs = Module.GetConfig().Stats.ModuleLoadSpanThresholdMs;
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("module_load_stats"));
+
+	const double LoadBucketsRaw[] = { 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000 };
+	const FOtelHistogramBuckets LoadBuckets = FOtelHistogramBuckets::From(LoadBucketsRaw);
+	HistogramLoadTimeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("module_load_stats_load_time"), LoadBuckets, EUnit::Milliseconds);
+
+	PhaseStartTime = FOtelTimestamp::Now();
+	LastEventTime = PhaseStartTime;
+	LastEventSeconds = FPlatformTime::Seconds();
+
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FOtelModuleLoadStats::OnModulesChanged);
+	LoadingPhaseCompleteHandle = IPluginManager::Get().OnLoadingPhaseComplete().AddRaw(this, &FOtelModuleLoadStats::OnLoadingPhaseComplete);
+}
+
+FOtelModuleLoadStats::~FOtelModuleLoadStats()
+{
+	Unbind();
+}
+
+void FOtelModuleLoadStats::Unbind()
+{
+	if (ModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+		ModulesChangedHandle.Reset();
+	}
+
+	if (LoadingPhaseCompleteHandle.IsValid())
+	{
+		IPluginManager::Get().OnLoadingPhaseComplete().Remove(LoadingPhaseCompleteHandle);
+		LoadingPhaseCompleteHandle.Reset();
+	}
+}
+
+void FOtelModuleLoadStats::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason != EModuleChangeReason::ModuleLoaded || IsInGameThread() == false)
+	{
+		return;
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	FModuleLoad& Load = PhaseModules.AddDefaulted_GetRef();
+	Load.ModuleName = ModuleName;
+	Load.StartTime = LastEventTime;
+	Load.EndTime = FOtelTimestamp::Now();
+	Load.DurationMs = (NowSeconds - LastEventSeconds) * 1000.0;
+
+	LastEventTime = Load.EndTime;
+	LastEventSeconds = NowSeconds;
+}
+
+void FOtelModuleLoadStats::OnLoadingPhaseComplete(ELoadingPhase::Type LoadingPhase, bool bSuccess)
+{
+	const FOtelTimestamp PhaseEndTime = FOtelTimestamp::Now();
+	const TCHAR* PhaseName = ELoadingPhase::ToString(LoadingPhase);
+
+	double TotalModuleMs = 0.0;
+	for (const FModuleLoad& Load : PhaseModules)
+	{
+		TotalModuleMs += Load.DurationMs;
+	}
+
+	const FAnalyticsEventAttribute PhaseAttributes[] = {
+		FAnalyticsEventAttribute(TEXT("phase"), PhaseName),
+		FAnalyticsEventAttribute(TEXT("module_count"), PhaseModules.Num()),
+		FAnalyticsEventAttribute(TEXT("module_time_ms"), TotalModuleMs),
+		FAnalyticsEventAttribute(TEXT("success"), bSuccess),
+		FAnalyticsEventAttribute(TEXT("timing"), TEXT("gap_estimate"))
+	};
+
+	FOtelTracer Tracer = Module.GetTracer();
+	const FOtelSpan StartupSpan = Module.GetStartupSpan();
+	FOtelSpan PhaseSpan = Tracer.StartSpanOpts(TEXT("ModuleLoadingPhase"), TEXT(__FILE__), __LINE__, &StartupSpan, PhaseAttributes, &PhaseStartTime);
+
+	const FAnalyticsEventAttribute HistogramAttributes[] = { FAnalyticsEventAttribute(TEXT("phase"), PhaseName) };
+	for (FModuleLoad& Load : PhaseModules)
+	{
+		HistogramLoadTimeMs->Record(Load.DurationMs, HistogramAttributes);
+
+		if (Load.DurationMs >= SpanThresholdMs)
+		{
+			const FAnalyticsEventAttribute ModuleAttributes[] = {
+				FAnalyticsEventAttribute(TEXT("module"), Load.ModuleName.ToString()),
+				FAnalyticsEventAttribute(TEXT("timing"), TEXT("gap_estimate"))
+			};
+			FOtelSpan ModuleSpan = Tracer.StartSpanOpts(TEXT("LoadModule"), TEXT(__FILE__), __LINE__, &PhaseSpan, ModuleAttributes, &Load.StartTime);
+			ModuleSpan.End(&Load.EndTime);
+		}
+	}
+
+	PhaseSpan.End(&PhaseEndTime);
+
+	PhaseModules.Reset();
+	PhaseStartTime = PhaseEndTime;
+	LastEventTime = PhaseEndTime;
+	LastEventSeconds = FPlatformTime::Seconds();
+
+	if (LoadingPhase == ELoadingPhase::PostEngineInit)
+	{
+		Unbind();
+	}
+}
@@ -0,0 +1,49 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+#include "ModuleDescriptor.h"
+#include "Modules/ModuleManager.h"
+
+// Attributes startup time to modules. The module manager only reports when a module has finished loading, so each
+// module is charged the time since the previous module or loading phase event. That is an estimate: dependencies a
+// module loads from its StartupModule() finish first and take the part of its time spent before them, and any engine
+// work between two loads is charged to the next module, and the spans say so with timing=gap_estimate. When a loading
+// phase completes it gets a span with the module count and total module time, with child spans for the modules over
+// the threshold. In the editor the phase spans are part of the startup timeline, see FOtelModule::GetStartupSpan. Phases before this plugin's PreDefault phase are missed, and tracking stops after
+// the PostEngineInit phase, since later loads happen on demand and the gaps between them aren't load time.
+class FOtelModuleLoadStats
+{
+public:
+	FOtelModuleLoadStats(FOtelModule& InModule);
+	~FOtelModuleLoadStats();
+
+private:
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+	void OnLoadingPhaseComplete(ELoadingPhase::Type LoadingPhase, bool bSuccess);
+	void Unbind();
+
+	struct FModuleLoad
+	{
+		FName ModuleName;
+		FOtelTimestamp StartTime;
+		FOtelTimestamp EndTime;
+		double DurationMs = 0.0;
+	};
+
+	FOtelModule& Module;
+	double SpanThresholdMs = 0.0;
+
+	TSharedPtr<FOtelHistogram> HistogramLoadTimeMs;
+
+	// All modules loaded in the current phase, only accessed on the game thread
+	TArray<FModuleLoad> PhaseModules;
+	FOtelTimestamp PhaseStartTime;
+	FOtelTimestamp LastEventTime;
+	double LastEventSeconds = 0.0;
+
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle LoadingPhaseCompleteHandle;
+};
@@ -0,0 +1,87 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelNetStats.h"
+#include "OtelWorldTracker.h"
+
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+FOtelNetStats::FOtelNetStats(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker)
+	: Module(InModule)
+	, WorldTracker(InWorldTracker)
+{
+	FOtelMeter Meter = Module.GetMeter(TEXT("net_stats"));
+
+	const double PingBucketsRaw[] = { 5, 10, 20, 30, 50, 75, 100, 150, 200 };
+	const FOtelHistogramBuckets PingBuckets = FOtelHistogramBuckets::From(PingBucketsRaw);
+
+	HistogramPingMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_ping"), PingBuckets, EUnit::Milliseconds);
+
+	const uint64 KB = 1024;
+	const uint64 InOutBytesBucketsRaw[] = { 0, KB / 2, KB, KB * 2, KB * 4, KB * 8, KB * 16, KB * 32, KB * 64 };
+	const FOtelHistogramBuckets InOutBytesBuckets = FOtelHistogramBuckets::From(InOutBytesBucketsRaw);
+
+	HistogramInBytes = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("net_stats_bytes_in"), InOutBytesBuckets, EUnit::Bytes);
+	HistogramOutBytes = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("net_stats_bytes_out"), InOutBytesBuckets, EUnit::Bytes);
+
+	const double PacketLossPctBucketsRaw[] = { 0, 0.05, 0.1, 0.2, 0.3, 0.5, 0.75, 1 };
+	const FOtelHistogramBuckets PacketLossPctBuckets = FOtelHistogramBuckets::From(PacketLossPctBucketsRaw);
+
+	HistogramInPacketLossPct = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_packet_loss_pct_in"), PacketLossPctBuckets);
+	HistogramOutPacketLossPct = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_packet_loss_pct_out"), PacketLossPctBuckets);
+
+	Module.RegisterCollector(this);
+}
+
+FOtelNetStats::~FOtelNetStats()
+{
+	Module.UnregisterCollector(this);
+}
+
+FName FOtelNetStats::GetName() const
+{
+	return TEXT("NetStats");
+}
+
+FOtelCollectorSettings FOtelNetStats::GetDefaultSettings() const
+{
+	// Connections only update their rates and loss once per StatPeriod, which defaults to a second
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 1.0;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
+
+void FOtelNetStats::Collect(double DeltaSeconds)
+{
+	for (FOtelTrackedWorld& Tracked : WorldTracker.GetWorlds())
+	{
+		UWorld* World = Tracked.World.Get();
+		APlayerController* LocalPC = World ? GEngine->GetFirstLocalPlayerController(World) : nullptr;
+		if (LocalPC == nullptr)
+		{
+			continue;
+		}
+
+		if (APlayerState* PS = LocalPC->GetPlayerState<APlayerState>())
+		{
+			double PingMs = PS->GetPingInMilliseconds();
+			HistogramPingMs->Record(PingMs, Tracked.Attributes);
+		}
+
+		if (UNetConnection* NetConnection = LocalPC->GetNetConnection())
+		{
+			const uint64 InBytes = static_cast<uint64>(FMath::Max(0, NetConnection->InBytesPerSecond));
+			const uint64 OutBytes = static_cast<uint64>(FMath::Max(0, NetConnection->OutBytesPerSecond));
+			const double InPacketLossPct = NetConnection->GetInLossPercentage().GetLossPercentage();
+			const double OutPacketLossPct = NetConnection->GetOutLossPercentage().GetLossPercentage();
+
+			HistogramInBytes->Record(InBytes, Tracked.Attributes);
+			HistogramOutBytes->Record(OutBytes, Tracked.Attributes);
+			HistogramInPacketLossPct->Record(InPacketLossPct, Tracked.Attributes);
+			HistogramOutPacketLossPct->Record(OutPacketLossPct, Tracked.Attributes);
+		}
+	}
+}
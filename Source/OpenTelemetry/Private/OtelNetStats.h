@@ -0,0 +1,31 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+class FOtelWorldTracker;
+
+// Records the local player's ping, bandwidth and packet loss for every world with a local player controller, so
+// multi-client PIE gets one series per client. See FOtelServerNetStats for the server side.
+class FOtelNetStats : public IOtelCollector
+{
+public:
+	FOtelNetStats(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker);
+	~FOtelNetStats();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	FOtelModule& Module;
+	FOtelWorldTracker& WorldTracker;
+
+	TSharedPtr<FOtelHistogram> HistogramPingMs;
+	TSharedPtr<FOtelHistogram> HistogramInBytes;
+	TSharedPtr<FOtelHistogram> HistogramOutBytes;
+	TSharedPtr<FOtelHistogram> HistogramInPacketLossPct;
+	TSharedPtr<FOtelHistogram> HistogramOutPacketLossPct;
+};
@@ -0,0 +1,190 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelOverhead.h"
+
+#include <atomic>
+
+DEFINE_STAT(STAT_Otel_SpanStart);
+DEFINE_STAT(STAT_Otel_SpanEnd);
+DEFINE_STAT(STAT_Otel_AttributeConversion);
+DEFINE_STAT(STAT_Otel_EmitLog);
+DEFINE_STAT(STAT_Otel_LogSerialize);
+DEFINE_STAT(STAT_Otel_InstrumentRecord);
+
+static const TCHAR* OtelOverheadOperationNames[] =
+{
+	TEXT("span_start"),
+	TEXT("span_end"),
+	TEXT("attribute_conversion"),
+	TEXT("emit_log"),
+	TEXT("log_serialize"),
+	TEXT("instrument_record"),
+};
+static_assert(UE_ARRAY_COUNT(OtelOverheadOperationNames) == (int32)EOtelOverhead::Count, "Missing overhead operation name");
+
+struct FOtelThreadOverhead;
+
+struct FOtelOverheadRegistry
+{
+	TArray<FOtelThreadOverhead*> Threads;
+	FOtelOverheadTotals Retired;
+};
+
+// Never destroyed, since threads can exit after static destruction has started
+static FOtelUnlockedData<FOtelOverheadRegistry>& GetOverheadRegistry()
+{
+	static FOtelUnlockedData<FOtelOverheadRegistry>* Registry = new FOtelUnlockedData<FOtelOverheadRegistry>();
+	return *Registry;
+}
+
+// Only written by the owning thread, so the atomics just make the values safe to read from the exporter thread
+struct FOtelThreadOverhead
+{
+	std::atomic<uint64> Cycles[(int32)EOtelOverhead::Count] = {};
+	std::atomic<uint64> Calls[(int32)EOtelOverhead::Count] = {};
+	std::atomic<uint64> TotalCycles = 0;
+
+	uint8 Depth[(int32)EOtelOverhead::Count] = {};
+	uint8 TotalDepth = 0;
+	bool bGameThread = false;
+
+	// Created on the thread's first overhead scope
+	FOtelThreadOverhead()
+		: bGameThread(IsInGameThread())
+	{
+		GetOverheadRegistry().Lock()->Threads.Add(this);
+	}
+
+	~FOtelThreadOverhead()
+	{
+		FOtelLockedData<FOtelOverheadRegistry> Registry = GetOverheadRegistry().Lock();
+		AddTo(Registry->Retired);
+		Registry->Threads.RemoveSingleSwap(this);
+	}
+
+	void AddTo(FOtelOverheadTotals& Totals) const
+	{
+		for (int32 i = 0; i < (int32)EOtelOverhead::Count; ++i)
+		{
+			Totals.Cycles[i] += Cycles[i].load(std::memory_order_relaxed);
+			Totals.Calls[i] += Calls[i].load(std::memory_order_relaxed);
+		}
+		const uint64 ThreadTotalCycles = TotalCycles.load(std::memory_order_relaxed);
+		Totals.TotalCycles += ThreadTotalCycles;
+		if (bGameThread)
+		{
+			Totals.GameThreadCycles += ThreadTotalCycles;
+		}
+	}
+
+	static void Accumulate(std::atomic<uint64>& Value, uint64 Delta)
+	{
+		Value.store(Value.load(std::memory_order_relaxed) + Delta, std::memory_order_relaxed);
+	}
+};
+
+static thread_local FOtelThreadOverhead ThreadOverhead;
+
+FOtelOverheadTotals FOtelOverheadTotals::Gather()
+{
+	FOtelLockedData<FOtelOverheadRegistry> Registry = GetOverheadRegistry().Lock();
+
+	FOtelOverheadTotals Totals = Registry->Retired;
+	for (const FOtelThreadOverhead* Thread : Registry->Threads)
+	{
+		Thread->AddTo(Totals);
+	}
+	return Totals;
+}
+
+FOtelOverheadScope::FOtelOverheadScope(EOtelOverhead InOperation)
+	: StartCycles(FPlatformTime::Cycles64())
+	, Operation(InOperation)
+{
+	++ThreadOverhead.Depth[(int32)Operation];
+	++ThreadOverhead.TotalDepth;
+}
+
+FOtelOverheadScope::~FOtelOverheadScope()
+{
+	const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+	const int32 Index = (int32)Operation;
+
+	if (--ThreadOverhead.Depth[Index] == 0)
+	{
+		FOtelThreadOverhead::Accumulate(ThreadOverhead.Cycles[Index], Cycles);
+		FOtelThreadOverhead::Accumulate(ThreadOverhead.Calls[Index], 1);
+	}
+
+	if (--ThreadOverhead.TotalDepth == 0)
+	{
+		FOtelThreadOverhead::Accumulate(ThreadOverhead.TotalCycles, Cycles);
+	}
+}
+
+FOtelOverhead::FOtelOverhead(FOtelModule& InModule)
+	: Module(InModule)
+{
+	FOtelMeter Meter = Module.GetMeter(TEXT("otel_overhead"));
+
+	Instruments.Add(Meter.CreateObservableCounter(EOtelInstrumentType::Double, TEXT("otel_overhead_time"), [this, Index = Instruments.Num()](FOtelObserver& Observer)
+		{
+			UpdateSnapshot(Index);
+			for (int32 i = 0; i < (int32)EOtelOverhead::Count; ++i)
+			{
+				const FAnalyticsEventAttribute Attributes[] = { FAnalyticsEventAttribute(TEXT("operation"), OtelOverheadOperationNames[i]) };
+				Observer.Observe(FPlatformTime::ToMilliseconds64(Snapshot.Cycles[i]), Attributes);
+			}
+		},
+		EUnit::Milliseconds));
+
+	Instruments.Add(Meter.CreateObservableCounter(EOtelInstrumentType::Int64, TEXT("otel_overhead_calls"), [this, Index = Instruments.Num()](FOtelObserver& Observer)
+		{
+			UpdateSnapshot(Index);
+			for (int32 i = 0; i < (int32)EOtelOverhead::Count; ++i)
+			{
+				const FAnalyticsEventAttribute Attributes[] = { FAnalyticsEventAttribute(TEXT("operation"), OtelOverheadOperationNames[i]) };
+				Observer.Observe(static_cast<int64>(Snapshot.Calls[i]), Attributes);
+			}
+		}));
+
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("otel_overhead_frame_time"), [this, Index = Instruments.Num()](FOtelObserver& Observer)
+		{
+			UpdateSnapshot(Index);
+			if (FrameAverageMs.IsSet())
+			{
+				Observer.Observe(FrameAverageMs.GetValue(), {});
+			}
+		},
+		EUnit::Milliseconds));
+}
+
+FOtelOverhead::~FOtelOverhead()
+{
+	// Unregister the callbacks before the snapshot they use goes away
+	Instruments.Reset();
+}
+
+void FOtelOverhead::UpdateSnapshot(int32 InstrumentIndex)
+{
+	if (SnapshotGate.BeginObserve(InstrumentIndex) == false)
+	{
+		return;
+	}
+
+	Snapshot = FOtelOverheadTotals::Gather();
+
+	// Averaged over the frames since the previous snapshot, since the exporter doesn't run in step with the game thread
+	const uint64 FrameCounter = GFrameCounter;
+	if (LastFrameCounter != 0 && FrameCounter > LastFrameCounter)
+	{
+		const uint64 DeltaCycles = Snapshot.TotalCycles - LastTotalCycles;
+		FrameAverageMs = FPlatformTime::ToMilliseconds64(DeltaCycles) / static_cast<double>(FrameCounter - LastFrameCounter);
+	}
+	else
+	{
+		FrameAverageMs.Reset();
+	}
+	LastFrameCounter = FrameCounter;
+	LastTotalCycles = Snapshot.TotalCycles;
+}
@@ -0,0 +1,83 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Otel"), STATGROUP_Otel, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Span Start"), STAT_Otel_SpanStart, STATGROUP_Otel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Span End"), STAT_Otel_SpanEnd, STATGROUP_Otel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attribute Conversion"), STAT_Otel_AttributeConversion, STATGROUP_Otel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Emit Log"), STAT_Otel_EmitLog, STATGROUP_Otel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Log Serialize"), STAT_Otel_LogSerialize, STATGROUP_Otel, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Instrument Record"), STAT_Otel_InstrumentRecord, STATGROUP_Otel, );
+
+// Plugin operations whose own cost is tracked. Keep in sync with OtelOverheadOperationNames.
+enum class EOtelOverhead : uint8
+{
+	SpanStart,
+	SpanEnd,
+	AttributeConversion,
+	EmitLog,
+	LogSerialize,
+	InstrumentRecord,
+	Count
+};
+
+// Accumulates the time spent in an operation into the calling thread's accumulator. Nested scopes of the same
+// operation (e.g. StartSpanScopedOpts calling StartSpanOpts) are only counted once, and the overall total only counts
+// the outermost scope, so operations calling each other don't inflate the total.
+class FOtelOverheadScope
+{
+public:
+	FOtelOverheadScope(EOtelOverhead InOperation);
+	~FOtelOverheadScope();
+
+private:
+	uint64 StartCycles;
+	EOtelOverhead Operation;
+};
+
+// Sums of all thread accumulators, including threads that have exited
+struct FOtelOverheadTotals
+{
+	uint64 Cycles[(int32)EOtelOverhead::Count] = {};
+	uint64 Calls[(int32)EOtelOverhead::Count] = {};
+	uint64 TotalCycles = 0;
+
+	// The part of TotalCycles spent on the game thread
+	uint64 GameThreadCycles = 0;
+
+	static FOtelOverheadTotals Gather();
+};
+
+// Times a plugin operation for both the otel_overhead metrics and `stat otel`
+#define OTEL_OVERHEAD_SCOPE(Operation) \
+	SCOPE_CYCLE_COUNTER(STAT_Otel_##Operation); \
+	FOtelOverheadScope PREPROCESSOR_JOIN(OtelOverheadScope, __LINE__)(EOtelOverhead::Operation)
+
+// Publishes the time the plugin spends in its own instrumentation, summed over all threads: cumulative time and call
+// counts per operation, and the average overhead per frame since the last collection. The stat counters only cover
+// the frame being displayed, so these are what a telemetry budget should be enforced against.
+class FOtelOverhead
+{
+public:
+	FOtelOverhead(FOtelModule& InModule);
+	~FOtelOverhead();
+
+private:
+	void UpdateSnapshot(int32 InstrumentIndex);
+
+	FOtelModule& Module;
+
+	// Only accessed from the exporter thread. All instruments of one collection report the same snapshot.
+	FOtelSnapshotGate SnapshotGate;
+	FOtelOverheadTotals Snapshot;
+	uint64 LastFrameCounter = 0;
+	uint64 LastTotalCycles = 0;
+	TOptional<double> FrameAverageMs;
+
+	TArray<TSharedPtr<FOtelObservableInstrument>> Instruments;
+};
@@ -0,0 +1,112 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelPlatformTime.h"
+
+#include "CoreGlobals.h"
+
+#if PLATFORM_WINDOWS
+
+#include "Windows/WindowsSystemIncludes.h"
+#include "Windows/WindowsHWrapper.h"
+
+// helpers ripped from WindowsPlatformTime.cpp
+namespace TimeHelpers
+{
+	/**
+	 * @return number of ticks based on the specified Filetime.
+	 */
+	static FORCEINLINE uint64 TicksFromFileTime(const FILETIME& Filetime)
+	{
+		const uint64 NumTicks = (uint64(Filetime.dwHighDateTime) << 32) + Filetime.dwLowDateTime;
+		return NumTicks;
+	}
+
+	/**
+	 * @return number of seconds based on the specified Filetime.
+	 */
+	static FORCEINLINE double ToSeconds(const FILETIME& Filetime)
+	{
+		return double(TicksFromFileTime(Filetime)) / double(ETimespan::TicksPerSecond);
+	}
+}; // namespace TimeHelpers
+
+double BVPlatformTime::ProcessUptimeSeconds()
+{
+	static double LastTotalProcessTime = 0.0f;
+
+	FILETIME CreationTime = { 0 };
+	FILETIME ExitTime = { 0 };
+	FILETIME KernelTime = { 0 };
+	FILETIME UserTime = { 0 };
+	FILETIME CurrentTime = { 0 };
+
+	::GetProcessTimes(::GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime);
+	::GetSystemTimeAsFileTime(&CurrentTime);
+
+	const double CurrentTotalProcessTime = TimeHelpers::ToSeconds(CurrentTime) - TimeHelpers::ToSeconds(CreationTime);
+	return CurrentTotalProcessTime;
+}
+
+#elif PLATFORM_LINUX
+
+#include "OtelProcFile.h"
+
+#include <unistd.h>
+
+// getrusage() only reports CPU time, so the wall clock uptime is worked out from the process start time in
+// /proc/self/stat, which is in clock ticks since boot, and the time since boot from /proc/uptime
+static double ReadProcUptimeSeconds()
+{
+	ANSICHAR Stat[1024];
+	ANSICHAR SystemUptime[128];
+	if (BVPlatformProc::ReadFile("/proc/self/stat", Stat, sizeof(Stat)) == false || BVPlatformProc::ReadFile("/proc/uptime", SystemUptime, sizeof(SystemUptime)) == false)
+	{
+		return 0.0;
+	}
+
+	// The executable name in field 2 can contain spaces, so count fields from the closing parenthesis. See proc(5) for
+	// the field layout.
+	const ANSICHAR* NameEnd = strrchr(Stat, ')');
+	if (NameEnd == nullptr || NameEnd[1] == 0)
+	{
+		return 0.0;
+	}
+
+	const ANSICHAR* Field = BVPlatformProc::SkipFields(NameEnd + 2, 19); // (22) starttime
+	if (*Field == 0)
+	{
+		return 0.0;
+	}
+
+	const long TicksPerSecond = sysconf(_SC_CLK_TCK);
+	if (TicksPerSecond <= 0)
+	{
+		return 0.0;
+	}
+
+	const double StartSeconds = static_cast<double>(strtoull(Field, nullptr, 10)) / static_cast<double>(TicksPerSecond);
+	const double SystemUptimeSeconds = strtod(SystemUptime, nullptr);
+	return FMath::Max(0.0, SystemUptimeSeconds - StartSeconds);
+}
+
+double BVPlatformTime::ProcessUptimeSeconds()
+{
+	const double UptimeSeconds = ReadProcUptimeSeconds();
+	if (UptimeSeconds > 0.0)
+	{
+		return UptimeSeconds;
+	}
+
+	// GStartTime is taken during static init, which is close enough to process start
+	return FPlatformTime::Seconds() - GStartTime;
+}
+
+#else
+
+double BVPlatformTime::ProcessUptimeSeconds()
+{
+	// GStartTime is taken during static init, which is close enough to process start
+	return FPlatformTime::Seconds() - GStartTime;
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelProcFile.h"
+
+#if PLATFORM_LINUX
+
+#include <fcntl.h>
+#include <unistd.h>
+
+bool BVPlatformProc::ReadFile(const ANSICHAR* Path, ANSICHAR* Buffer, int32 BufferSize)
+{
+	const int File = open(Path, O_RDONLY | O_CLOEXEC);
+	if (File < 0)
+	{
+		return false;
+	}
+
+	const ssize_t BytesRead = read(File, Buffer, BufferSize - 1);
+	close(File);
+
+	if (BytesRead <= 0)
+	{
+		return false;
+	}
+
+	Buffer[BytesRead] = 0;
+	return true;
+}
+
+const ANSICHAR* BVPlatformProc::SkipFields(const ANSICHAR* Cursor, int32 NumFields)
+{
+	while (NumFields > 0 && *Cursor != 0)
+	{
+		if (*Cursor == ' ')
+		{
+			--NumFields;
+		}
+		++Cursor;
+	}
+	return Cursor;
+}
+
+#endif // PLATFORM_LINUX
@@ -0,0 +1,17 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if PLATFORM_LINUX
+namespace BVPlatformProc
+{
+	// Reads a procfs file into Buffer and null terminates it. procfs files report a size of 0, so they're read up to
+	// EOF rather than by their file size. Returns false if the file couldn't be read, e.g. a thread that has exited.
+	bool ReadFile(const ANSICHAR* Path, ANSICHAR* Buffer, int32 BufferSize);
+
+	// Returns the start of the field NumFields space-separated fields after Cursor
+	const ANSICHAR* SkipFields(const ANSICHAR* Cursor, int32 NumFields);
+}
+#endif
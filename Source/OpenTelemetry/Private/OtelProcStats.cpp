@@ -0,0 +1,382 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelProcStats.h"
+
+#if PLATFORM_LINUX
+
+#include "OtelProcFile.h"
+
+#include "Algo/BinarySearch.h"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// All instruments are observed back to back during a collection, so they share one parse of /proc
+static const double ProcRefreshSeconds = 1.0;
+
+// Thread pools grow past what's reasonable to report individually, so past this everything goes into "Other"
+static const int32 MaxThreadGroups = 48;
+
+static uint64 ParseStatusValue(const ANSICHAR* Buffer, const ANSICHAR* Key)
+{
+	if (const ANSICHAR* Line = strstr(Buffer, Key))
+	{
+		return strtoull(Line + strlen(Key), nullptr, 10);
+	}
+	return 0;
+}
+
+// Thread pools are named "<Pool> <Index>" or similar, so strip any trailing index to group them
+static void CopyThreadGroupName(ANSICHAR (&Dest)[16], const ANSICHAR* Source)
+{
+	FCStringAnsi::Strncpy(Dest, Source, UE_ARRAY_COUNT(Dest));
+
+	int32 Length = FCStringAnsi::Strlen(Dest);
+	while (Length > 1 && (FCharAnsi::IsDigit(Dest[Length - 1]) || Dest[Length - 1] == ' ' || Dest[Length - 1] == '#' || Dest[Length - 1] == '-' || Dest[Length - 1] == '_'))
+	{
+		--Length;
+	}
+	Dest[Length] = 0;
+}
+
+FOtelProcStats::FOtelProcStats(FOtelModule& InModule)
+{
+	TicksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+	Tasks.Reserve(256);
+	PreviousTasks.Reserve(256);
+	ThreadGroups.Reserve(MaxThreadGroups + 1);
+
+	UserAttributes.Add(FAnalyticsEventAttribute(TEXT("state"), TEXT("user")));
+	SystemAttributes.Add(FAnalyticsEventAttribute(TEXT("state"), TEXT("system")));
+	VoluntaryAttributes.Add(FAnalyticsEventAttribute(TEXT("type"), TEXT("voluntary")));
+	InvoluntaryAttributes.Add(FAnalyticsEventAttribute(TEXT("type"), TEXT("involuntary")));
+	MinorFaultAttributes.Add(FAnalyticsEventAttribute(TEXT("type"), TEXT("minor")));
+	MajorFaultAttributes.Add(FAnalyticsEventAttribute(TEXT("type"), TEXT("major")));
+
+	FOtelMeter Meter = InModule.GetMeter(TEXT("proc_stats"));
+
+	Instruments.Add(Meter.CreateObservableCounter(EOtelInstrumentType::Double, TEXT("proc_stats_cpu_time"), [this](FOtelObserver& Observer)
+		{
+			ObserveCpuTime(Observer);
+		},
+		EUnit::Seconds));
+
+	Instruments.Add(Meter.CreateObservableCounter(EOtelInstrumentType::Int64, TEXT("proc_stats_context_switches"), [this](FOtelObserver& Observer)
+		{
+			ObserveContextSwitches(Observer);
+		}));
+
+	Instruments.Add(Meter.CreateObservableCounter(EOtelInstrumentType::Int64, TEXT("proc_stats_page_faults"), [this](FOtelObserver& Observer)
+		{
+			ObservePageFaults(Observer);
+		}));
+
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("proc_stats_memory_rss"), [this](FOtelObserver& Observer)
+		{
+			ObserveRss(Observer);
+		},
+		EUnit::Bytes));
+
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("proc_stats_threads"), [this](FOtelObserver& Observer)
+		{
+			ObserveThreads(Observer);
+		}));
+
+	// Reported as utilization over the last collection interval rather than a running total, since threads come and go
+	// and their totals would make the counter go backwards
+	Instruments.Add(Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("proc_stats_thread_cpu_utilization"), [this](FOtelObserver& Observer)
+		{
+			ObserveThreadCpu(Observer);
+		}));
+}
+
+FOtelProcStats::~FOtelProcStats()
+{
+	Instruments.Reset();
+}
+
+void FOtelProcStats::RefreshIfStale()
+{
+	const double Now = FPlatformTime::Seconds();
+	const double ElapsedSeconds = Now - LastRefreshSeconds;
+	if (ElapsedSeconds < ProcRefreshSeconds)
+	{
+		return;
+	}
+
+	ParseProcessStat();
+	ParseProcessStatus();
+	ParseTasks();
+
+	// The first refresh has no previous samples to diff against
+	if (LastRefreshSeconds > 0.0)
+	{
+		UpdateThreadGroups(ElapsedSeconds);
+	}
+
+	LastRefreshSeconds = Now;
+}
+
+bool FOtelProcStats::ReadProcFile(const ANSICHAR* Path)
+{
+	return BVPlatformProc::ReadFile(Path, Buffer, sizeof(Buffer));
+}
+
+void FOtelProcStats::ParseProcessStat()
+{
+	if (ReadProcFile("/proc/self/stat") == false)
+	{
+		return;
+	}
+
+	// The process name is in parens and may itself contain spaces, so field numbering starts after the last paren.
+	// See proc(5) for the field layout.
+	const ANSICHAR* NameEnd = strrchr(Buffer, ')');
+	if (NameEnd == nullptr)
+	{
+		return;
+	}
+
+	const ANSICHAR* Field = NameEnd + 2; // (3) state
+	Field = BVPlatformProc::SkipFields(Field, 7); // (10) minflt
+	Process.MinorFaults = strtoull(Field, nullptr, 10);
+	Field = BVPlatformProc::SkipFields(Field, 2); // (12) majflt
+	Process.MajorFaults = strtoull(Field, nullptr, 10);
+	Field = BVPlatformProc::SkipFields(Field, 2); // (14) utime
+	Process.UserTicks = strtoull(Field, nullptr, 10);
+	Field = BVPlatformProc::SkipFields(Field, 1); // (15) stime
+	Process.SystemTicks = strtoull(Field, nullptr, 10);
+	Field = BVPlatformProc::SkipFields(Field, 5); // (20) num_threads
+	Process.NumThreads = strtoll(Field, nullptr, 10);
+}
+
+void FOtelProcStats::ParseProcessStatus()
+{
+	if (ReadProcFile("/proc/self/status") == false)
+	{
+		return;
+	}
+
+	Process.RssBytes = ParseStatusValue(Buffer, "\nVmRSS:") * 1024;
+	Process.VoluntarySwitches = ParseStatusValue(Buffer, "\nvoluntary_ctxt_switches:");
+	Process.InvoluntarySwitches = ParseStatusValue(Buffer, "\nnonvoluntary_ctxt_switches:");
+}
+
+void FOtelProcStats::ParseTasks()
+{
+	Swap(Tasks, PreviousTasks);
+	Tasks.Reset();
+
+	ReadTasks([this](const FTaskSample& Sample)
+		{
+			Tasks.Add(Sample);
+		});
+
+	Tasks.Sort([](const FTaskSample& A, const FTaskSample& B)
+		{
+			return A.Tid < B.Tid;
+		});
+}
+
+void FOtelProcStats::ReadTasks(TFunctionRef<void(const FTaskSample& Sample)> Visitor)
+{
+	DIR* TaskDir = opendir("/proc/self/task");
+	if (TaskDir == nullptr)
+	{
+		return;
+	}
+
+	while (const dirent* Entry = readdir(TaskDir))
+	{
+		if (Entry->d_name[0] == '.')
+		{
+			continue;
+		}
+
+		ANSICHAR Path[64];
+		FCStringAnsi::Snprintf(Path, sizeof(Path), "/proc/self/task/%s/stat", Entry->d_name);
+
+		// Threads can exit between listing the directory and reading their stats
+		if (ReadProcFile(Path) == false)
+		{
+			continue;
+		}
+
+		const ANSICHAR* NameStart = strchr(Buffer, '(');
+		const ANSICHAR* NameEnd = strrchr(Buffer, ')');
+		if (NameStart == nullptr || NameEnd == nullptr || NameEnd < NameStart)
+		{
+			continue;
+		}
+
+		FTaskSample Sample;
+		Sample.Tid = atoi(Entry->d_name);
+
+		const int32 NameLength = FMath::Min(static_cast<int32>(NameEnd - NameStart - 1), static_cast<int32>(UE_ARRAY_COUNT(Sample.Name) - 1));
+		FMemory::Memcpy(Sample.Name, NameStart + 1, NameLength);
+		Sample.Name[NameLength] = 0;
+
+		const ANSICHAR* Field = BVPlatformProc::SkipFields(NameEnd + 2, 11); // (14) utime
+		const uint64 UserTicks = strtoull(Field, nullptr, 10);
+		Field = BVPlatformProc::SkipFields(Field, 1); // (15) stime
+		const uint64 SystemTicks = strtoull(Field, nullptr, 10);
+		Sample.CpuTicks = UserTicks + SystemTicks;
+
+		Visitor(Sample);
+	}
+
+	closedir(TaskDir);
+}
+
+void FOtelProcStats::UpdateThreadGroups(double ElapsedSeconds)
+{
+	ThreadGroupElapsedSeconds = ElapsedSeconds;
+	for (FThreadGroup& Group : ThreadGroups)
+	{
+		Group.CpuTicks = 0;
+		Group.bSeen = false;
+	}
+
+	for (const FTaskSample& Task : Tasks)
+	{
+		const uint64 DeltaTicks = GetDeltaTicks(Task);
+
+		ANSICHAR GroupName[16];
+		CopyThreadGroupName(GroupName, Task.Name);
+
+		FThreadGroup* Group = ThreadGroups.FindByPredicate([&GroupName](const FThreadGroup& Existing)
+			{
+				return FCStringAnsi::Strcmp(Existing.Name, GroupName) == 0;
+			});
+
+		if (Group == nullptr)
+		{
+			if (ThreadGroups.Num() >= MaxThreadGroups)
+			{
+				FCStringAnsi::Strcpy(GroupName, "Other");
+				Group = ThreadGroups.FindByPredicate([&GroupName](const FThreadGroup& Existing)
+					{
+						return FCStringAnsi::Strcmp(Existing.Name, GroupName) == 0;
+					});
+			}
+
+			if (Group == nullptr)
+			{
+				Group = &ThreadGroups.AddDefaulted_GetRef();
+				FCStringAnsi::Strcpy(Group->Name, GroupName);
+				Group->Attributes.Add(FAnalyticsEventAttribute(TEXT("thread"), FString(GroupName)));
+			}
+		}
+
+		Group->CpuTicks += DeltaTicks;
+		Group->bSeen = true;
+	}
+
+	// Groups whose threads have all exited make room for new ones
+	ThreadGroups.RemoveAll([](const FThreadGroup& Group)
+		{
+			return Group.bSeen == false;
+		});
+}
+
+uint64 FOtelProcStats::GetDeltaTicks(const FTaskSample& Task) const
+{
+	// Threads that started since the last refresh spent all of their CPU time within this interval
+	const int32 PreviousIndex = Algo::BinarySearchBy(PreviousTasks, Task.Tid, &FTaskSample::Tid);
+	if (PreviousIndex != INDEX_NONE)
+	{
+		const uint64 PreviousTicks = PreviousTasks[PreviousIndex].CpuTicks;
+		return (Task.CpuTicks >= PreviousTicks) ? (Task.CpuTicks - PreviousTicks) : 0;
+	}
+	return Task.CpuTicks;
+}
+
+void FOtelProcStats::VisitThreadCpuTime(TFunctionRef<void(int32 Tid, const ANSICHAR* Name, double CpuSeconds)> Visitor)
+{
+	// Only for the shared read buffer, the cached samples aren't touched
+	FScopeLock Lock(&Mutex);
+
+	ReadTasks([this, &Visitor](const FTaskSample& Sample)
+		{
+			Visitor(Sample.Tid, Sample.Name, static_cast<double>(Sample.CpuTicks) / TicksPerSecond);
+		});
+}
+
+void FOtelProcStats::ObserveCpuTime(FOtelObserver& Observer)
+{
+	FScopeLock Lock(&Mutex);
+	RefreshIfStale();
+
+	Observer.Observe(static_cast<double>(Process.UserTicks) / TicksPerSecond, UserAttributes);
+	Observer.Observe(static_cast<double>(Process.SystemTicks) / TicksPerSecond, SystemAttributes);
+}
+
+void FOtelProcStats::ObserveContextSwitches(FOtelObserver& Observer)
+{
+	FScopeLock Lock(&Mutex);
+	RefreshIfStale();
+
+	Observer.Observe(static_cast<int64>(Process.VoluntarySwitches), VoluntaryAttributes);
+	Observer.Observe(static_cast<int64>(Process.InvoluntarySwitches), InvoluntaryAttributes);
+}
+
+void FOtelProcStats::ObservePageFaults(FOtelObserver& Observer)
+{
+	FScopeLock Lock(&Mutex);
+	RefreshIfStale();
+
+	Observer.Observe(static_cast<int64>(Process.MinorFaults), MinorFaultAttributes);
+	Observer.Observe(static_cast<int64>(Process.MajorFaults), MajorFaultAttributes);
+}
+
+void FOtelProcStats::ObserveRss(FOtelObserver& Observer)
+{
+	FScopeLock Lock(&Mutex);
+	RefreshIfStale();
+
+	Observer.Observe(static_cast<int64>(Process.RssBytes), {});
+}
+
+void FOtelProcStats::ObserveThreads(FOtelObserver& Observer)
+{
+	FScopeLock Lock(&Mutex);
+	RefreshIfStale();
+
+	Observer.Observe(Process.NumThreads, {});
+}
+
+void FOtelProcStats::ObserveThreadCpu(FOtelObserver& Observer)
+{
+	FScopeLock Lock(&Mutex);
+	RefreshIfStale();
+
+	if (ThreadGroupElapsedSeconds <= 0.0)
+	{
+		return;
+	}
+
+	for (const FThreadGroup& Group : ThreadGroups)
+	{
+		const double CpuSeconds = static_cast<double>(Group.CpuTicks) / TicksPerSecond;
+		Observer.Observe(CpuSeconds / ThreadGroupElapsedSeconds, Group.Attributes);
+	}
+}
+
+#else
+
+FOtelProcStats::FOtelProcStats(FOtelModule& InModule)
+{
+}
+
+FOtelProcStats::~FOtelProcStats()
+{
+}
+
+void FOtelProcStats::VisitThreadCpuTime(TFunctionRef<void(int32 Tid, const ANSICHAR* Name, double CpuSeconds)> Visitor)
+{
+}
+
+#endif // PLATFORM_LINUX
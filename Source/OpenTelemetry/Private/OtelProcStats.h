@@ -0,0 +1,88 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+// Process and per-thread resource usage read from /proc on Linux: CPU time, RSS, context switches, page faults, and CPU
+// utilization per named thread. Everything is exposed as observable instruments, so /proc is only parsed when metrics
+// are collected for export, into buffers that are reused between collections. Attributes are built once, or when a
+// thread group is first seen, so observing doesn't allocate.
+class FOtelProcStats
+{
+public:
+	FOtelProcStats(FOtelModule& InModule);
+	~FOtelProcStats();
+
+	// Calls Visitor with the id, name and total CPU time of every thread, read from /proc right away. The cached samples
+	// behind the instruments are left alone, so callers can diff these at their own cadence. Does nothing on platforms
+	// without /proc.
+	void VisitThreadCpuTime(TFunctionRef<void(int32 Tid, const ANSICHAR* Name, double CpuSeconds)> Visitor);
+
+private:
+#if PLATFORM_LINUX
+	struct FProcessSample
+	{
+		uint64 UserTicks = 0;
+		uint64 SystemTicks = 0;
+		uint64 MinorFaults = 0;
+		uint64 MajorFaults = 0;
+		uint64 VoluntarySwitches = 0;
+		uint64 InvoluntarySwitches = 0;
+		uint64 RssBytes = 0;
+		int64 NumThreads = 0;
+	};
+
+	struct FTaskSample
+	{
+		int32 Tid = 0;
+		uint64 CpuTicks = 0;
+		ANSICHAR Name[16] = {};
+	};
+
+	// Kept for as long as any of its threads are alive, so its attributes are only built once
+	struct FThreadGroup
+	{
+		ANSICHAR Name[16] = {};
+		uint64 CpuTicks = 0;
+		bool bSeen = false;
+		TArray<FAnalyticsEventAttribute> Attributes;
+	};
+
+	void RefreshIfStale();
+	bool ReadProcFile(const ANSICHAR* Path);
+	void ParseProcessStat();
+	void ParseProcessStatus();
+	void ParseTasks();
+	void ReadTasks(TFunctionRef<void(const FTaskSample& Sample)> Visitor);
+	void UpdateThreadGroups(double ElapsedSeconds);
+	uint64 GetDeltaTicks(const FTaskSample& Task) const;
+
+	void ObserveCpuTime(FOtelObserver& Observer);
+	void ObserveContextSwitches(FOtelObserver& Observer);
+	void ObservePageFaults(FOtelObserver& Observer);
+	void ObserveRss(FOtelObserver& Observer);
+	void ObserveThreads(FOtelObserver& Observer);
+	void ObserveThreadCpu(FOtelObserver& Observer);
+
+	FCriticalSection Mutex;
+	double TicksPerSecond = 100.0;
+	double LastRefreshSeconds = 0.0;
+	double ThreadGroupElapsedSeconds = 0.0;
+
+	FProcessSample Process;
+	TArray<FTaskSample> Tasks;
+	TArray<FTaskSample> PreviousTasks;
+	TArray<FThreadGroup> ThreadGroups;
+	ANSICHAR Buffer[4096];
+
+	TArray<FAnalyticsEventAttribute> UserAttributes;
+	TArray<FAnalyticsEventAttribute> SystemAttributes;
+	TArray<FAnalyticsEventAttribute> VoluntaryAttributes;
+	TArray<FAnalyticsEventAttribute> InvoluntaryAttributes;
+	TArray<FAnalyticsEventAttribute> MinorFaultAttributes;
+	TArray<FAnalyticsEventAttribute> MajorFaultAttributes;
+
+	TArray<TSharedPtr<FOtelObservableInstrument>> Instruments;
+#endif
+};
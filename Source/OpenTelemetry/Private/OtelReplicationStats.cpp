@@ -0,0 +1,169 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelReplicationStats.h"
+
+#include "UObject/Class.h"
+
+static const FName NAME_OtherClasses(TEXT("Other"));
+
+// Sorts Values from largest to smallest and keeps the first TopN, returning the sum of the rest
+static uint64 KeepTopValues(TArray<TPair<FName, uint64>>& Values, int32 TopN)
+{
+	Values.Sort([](const TPair<FName, uint64>& A, const TPair<FName, uint64>& B)
+		{
+			return A.Value > B.Value;
+		});
+
+	uint64 Rest = 0;
+	for (int32 i = TopN; i < Values.Num(); ++i)
+	{
+		Rest += Values[i].Value;
+	}
+	Values.SetNum(FMath::Min(TopN, Values.Num()));
+	return Rest;
+}
+
+FOtelReplicationStats::FOtelReplicationStats(FOtelModule& InModule)
+{
+	const FOtelConfig& Config = InModule.GetConfig();
+	TopClasses = Config.Stats.ReplicationTopClasses;
+	MaxRecordsPerFrame = Config.Stats.ReplicationMaxRecordsPerFrame;
+	MaxClasses = FMath::Max(TopClasses * 8, 256);
+
+	FOtelMeter Meter = InModule.GetMeter(TEXT("replication_stats"));
+	GaugeBytes = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("replication_stats_bytes"), [this](FOtelObserver& Observer)
+		{
+			ObserveBytes(Observer);
+		},
+		EUnit::Bytes);
+	GaugeCompareTime = Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("replication_stats_compare_time"), [this](FOtelObserver& Observer)
+		{
+			ObserveCompareTime(Observer);
+		},
+		EUnit::Milliseconds);
+	GaugeDroppedRecords = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("replication_stats_dropped_records"), [this](FOtelObserver& Observer)
+		{
+			UpdateSnapshot(GaugeIndexDroppedRecords);
+			Observer.Observe(SnapshotDroppedRecords, {});
+		});
+}
+
+FOtelReplicationStats::~FOtelReplicationStats()
+{
+	// Unregister the callbacks before the snapshot they use goes away
+	GaugeBytes.Reset();
+	GaugeCompareTime.Reset();
+	GaugeDroppedRecords.Reset();
+}
+
+void FOtelReplicationStats::Record(const UClass* ActorClass, uint32 NumBytes, uint32 CompareCycles)
+{
+	FOtelLockedData<FAccumulator> Locked = Accumulator.Lock();
+	if (Locked->BudgetFrame != GFrameCounter)
+	{
+		Locked->BudgetFrame = GFrameCounter;
+		Locked->FrameRecords = 0;
+	}
+
+	if (Locked->FrameRecords >= MaxRecordsPerFrame)
+	{
+		++Locked->DroppedRecords;
+		return;
+	}
+	++Locked->FrameRecords;
+
+	FName ClassName = ActorClass ? ActorClass->GetFName() : NAME_OtherClasses;
+	FClassCost* Cost = Locked->Costs.Find(ClassName);
+	if (Cost == nullptr)
+	{
+		if (Locked->Costs.Num() >= MaxClasses)
+		{
+			ClassName = NAME_OtherClasses;
+		}
+		Cost = &Locked->Costs.FindOrAdd(ClassName);
+	}
+
+	Cost->NumBytes += NumBytes;
+	Cost->CompareCycles += CompareCycles;
+}
+
+void FOtelReplicationStats::UpdateSnapshot(EGauge Gauge)
+{
+	if (SnapshotGate.BeginObserve(Gauge) == false)
+	{
+		return;
+	}
+
+	TMap<FName, FClassCost> Costs;
+	{
+		FOtelLockedData<FAccumulator> Locked = Accumulator.Lock();
+		Costs = MoveTemp(Locked->Costs);
+		Locked->Costs.Reset();
+		SnapshotDroppedRecords = Locked->DroppedRecords;
+		Locked->DroppedRecords = 0;
+	}
+
+	TopBytes.Reset();
+	TopCompareCycles.Reset();
+	OtherBytes = 0;
+	OtherCompareCycles = 0;
+	for (const TPair<FName, FClassCost>& Pair : Costs)
+	{
+		if (Pair.Key == NAME_OtherClasses)
+		{
+			OtherBytes = Pair.Value.NumBytes;
+			OtherCompareCycles = Pair.Value.CompareCycles;
+		}
+		else
+		{
+			TopBytes.Emplace(Pair.Key, Pair.Value.NumBytes);
+			TopCompareCycles.Emplace(Pair.Key, Pair.Value.CompareCycles);
+		}
+	}
+
+	// Classes that send the most aren't necessarily the ones that take longest to compare, so each is ranked on its own
+	OtherBytes += KeepTopValues(TopBytes, TopClasses);
+	OtherCompareCycles += KeepTopValues(TopCompareCycles, TopClasses);
+}
+
+void FOtelReplicationStats::ObserveBytes(FOtelObserver& Observer)
+{
+	UpdateSnapshot(GaugeIndexBytes);
+
+	for (const TPair<FName, uint64>& Pair : TopBytes)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("class"), Pair.Key.ToString()),
+		};
+		Observer.Observe(static_cast<int64>(Pair.Value), Attributes);
+	}
+
+	if (OtherBytes > 0)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("class"), NAME_OtherClasses.ToString()),
+		};
+		Observer.Observe(static_cast<int64>(OtherBytes), Attributes);
+	}
+}
+
+void FOtelReplicationStats::ObserveCompareTime(FOtelObserver& Observer)
+{
+	UpdateSnapshot(GaugeIndexCompareTime);
+
+	for (const TPair<FName, uint64>& Pair : TopCompareCycles)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("class"), Pair.Key.ToString()),
+		};
+		Observer.Observe(FPlatformTime::ToMilliseconds64(Pair.Value), Attributes);
+	}
+
+	if (OtherCompareCycles > 0)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("class"), NAME_OtherClasses.ToString()),
+		};
+		Observer.Observe(FPlatformTime::ToMilliseconds64(OtherCompareCycles), Attributes);
+	}
+}
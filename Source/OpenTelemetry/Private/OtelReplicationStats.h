@@ -0,0 +1,63 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+// Accumulates replication cost per actor class and reports the most expensive classes once per export interval. The
+// engine has no per-actor replication hook, so costs are fed in by net drivers or replication graphs through
+// OTEL_RECORD_REPLICATION. Recording is a single map update under an uncontended lock, and the number of records per
+// frame and the number of tracked classes are both capped, so the per-frame overhead is bounded regardless of load.
+class FOtelReplicationStats
+{
+public:
+	FOtelReplicationStats(FOtelModule& InModule);
+	~FOtelReplicationStats();
+
+	void Record(const UClass* ActorClass, uint32 NumBytes, uint32 CompareCycles);
+
+private:
+	struct FClassCost
+	{
+		uint64 NumBytes = 0;
+		uint64 CompareCycles = 0;
+	};
+
+	// Indices of the gauges for the snapshot gate
+	enum EGauge : int32
+	{
+		GaugeIndexBytes,
+		GaugeIndexCompareTime,
+		GaugeIndexDroppedRecords
+	};
+
+	void UpdateSnapshot(EGauge Gauge);
+	void ObserveBytes(FOtelObserver& Observer);
+	void ObserveCompareTime(FOtelObserver& Observer);
+
+	int32 TopClasses = 0;
+	int32 MaxRecordsPerFrame = 0;
+	int32 MaxClasses = 0;
+
+	TSharedPtr<FOtelObservableInstrument> GaugeBytes;
+	TSharedPtr<FOtelObservableInstrument> GaugeCompareTime;
+	TSharedPtr<FOtelObservableInstrument> GaugeDroppedRecords;
+
+	struct FAccumulator
+	{
+		TMap<FName, FClassCost> Costs;
+		uint64 BudgetFrame = 0;
+		int32 FrameRecords = 0;
+		int64 DroppedRecords = 0;
+	};
+	FOtelUnlockedData<FAccumulator> Accumulator;
+
+	// Only accessed from the exporter thread. All gauges of one collection report the same snapshot, in which each metric
+	// has its own top classes.
+	TArray<TPair<FName, uint64>> TopBytes;
+	TArray<TPair<FName, uint64>> TopCompareCycles;
+	uint64 OtherBytes = 0;
+	uint64 OtherCompareCycles = 0;
+	int64 SnapshotDroppedRecords = 0;
+	FOtelSnapshotGate SnapshotGate;
+};
@@ -0,0 +1,123 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelServerNetStats.h"
+#include "OtelWorldTracker.h"
+
+#include "Engine/Engine.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+FOtelServerNetStats::FOtelServerNetStats(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker)
+	: Module(InModule)
+	, WorldTracker(InWorldTracker)
+{
+	FOtelMeter Meter = Module.GetMeter(TEXT("net_stats"));
+
+	const double PingBucketsRaw[] = { 5, 10, 20, 30, 50, 75, 100, 150, 200, 300 };
+	const FOtelHistogramBuckets PingBuckets = FOtelHistogramBuckets::From(PingBucketsRaw);
+
+	HistogramPingMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_server_ping"), PingBuckets, EUnit::Milliseconds);
+
+	const uint64 KB = 1024;
+	const uint64 InOutBytesBucketsRaw[] = { 0, KB / 2, KB, KB * 2, KB * 4, KB * 8, KB * 16, KB * 32, KB * 64 };
+	const FOtelHistogramBuckets InOutBytesBuckets = FOtelHistogramBuckets::From(InOutBytesBucketsRaw);
+
+	HistogramInBytes = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("net_stats_server_bytes_in"), InOutBytesBuckets, EUnit::Bytes);
+	HistogramOutBytes = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("net_stats_server_bytes_out"), InOutBytesBuckets, EUnit::Bytes);
+
+	const double PacketLossPctBucketsRaw[] = { 0, 0.05, 0.1, 0.2, 0.3, 0.5, 0.75, 1 };
+	const FOtelHistogramBuckets PacketLossPctBuckets = FOtelHistogramBuckets::From(PacketLossPctBucketsRaw);
+
+	HistogramInPacketLossPct = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_server_packet_loss_pct_in"), PacketLossPctBuckets);
+	HistogramOutPacketLossPct = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_server_packet_loss_pct_out"), PacketLossPctBuckets);
+
+	GaugeConnections = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("net_stats_server_connections"), [this](FOtelObserver& Observer)
+		{
+			ObserveConnections(Observer);
+		});
+
+	Module.RegisterCollector(this);
+}
+
+FOtelServerNetStats::~FOtelServerNetStats()
+{
+	Module.UnregisterCollector(this);
+	GaugeConnections.Reset();
+}
+
+FName FOtelServerNetStats::GetName() const
+{
+	return TEXT("ServerNetStats");
+}
+
+FOtelCollectorSettings FOtelServerNetStats::GetDefaultSettings() const
+{
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 1.0;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
+
+void FOtelServerNetStats::Collect(double DeltaSeconds)
+{
+	// A push gauge only keeps the last value it was given, which would leave one world's count for all of them
+	FOtelLockedData<TArray<FWorldConnections>> Connections = LatestConnections.Lock();
+	Connections->Reset();
+
+	for (FOtelTrackedWorld& Tracked : WorldTracker.GetWorlds())
+	{
+		UWorld* World = Tracked.World.Get();
+		if (World == nullptr)
+		{
+			continue;
+		}
+
+		const ENetMode NetMode = World->GetNetMode();
+		UNetDriver* NetDriver = World->GetNetDriver();
+		if ((NetMode != NM_DedicatedServer && NetMode != NM_ListenServer) || NetDriver == nullptr)
+		{
+			continue;
+		}
+
+		TArrayView<FAnalyticsEventAttribute> Attributes = Tracked.Attributes;
+
+		int64 NumConnections = 0;
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection == nullptr || Connection->GetConnectionState() != USOCK_Open)
+			{
+				continue;
+			}
+			++NumConnections;
+
+			if (APlayerController* PC = Connection->PlayerController)
+			{
+				if (APlayerState* PS = PC->GetPlayerState<APlayerState>())
+				{
+					HistogramPingMs->Record(static_cast<double>(PS->GetPingInMilliseconds()), Attributes);
+				}
+			}
+
+			// Rates and loss are computed by the connection once per StatPeriod, so sampling more often just repeats values
+			HistogramInBytes->Record(static_cast<uint64>(FMath::Max(0, Connection->InBytesPerSecond)), Attributes);
+			HistogramOutBytes->Record(static_cast<uint64>(FMath::Max(0, Connection->OutBytesPerSecond)), Attributes);
+			HistogramInPacketLossPct->Record(Connection->GetInLossPercentage().GetLossPercentage(), Attributes);
+			HistogramOutPacketLossPct->Record(Connection->GetOutLossPercentage().GetLossPercentage(), Attributes);
+		}
+
+		FWorldConnections& WorldConnections = Connections->AddDefaulted_GetRef();
+		WorldConnections.Attributes = Tracked.Attributes;
+		WorldConnections.NumConnections = NumConnections;
+	}
+}
+
+void FOtelServerNetStats::ObserveConnections(FOtelObserver& Observer)
+{
+	FOtelLockedData<TArray<FWorldConnections>> Connections = LatestConnections.Lock();
+	for (const FWorldConnections& WorldConnections : *Connections)
+	{
+		Observer.Observe(WorldConnections.NumConnections, WorldConnections.Attributes);
+	}
+}
@@ -0,0 +1,44 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+class FOtelWorldTracker;
+
+// Samples every client connection of server worlds at a fixed interval. FOtelNetStats only covers the local player's
+// connection, which dedicated servers don't have. Connections are aggregated into histograms attributed by map only, so
+// the number of series doesn't grow with the number of players.
+class FOtelServerNetStats : public IOtelCollector
+{
+public:
+	FOtelServerNetStats(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker);
+	~FOtelServerNetStats();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	struct FWorldConnections
+	{
+		TArray<FAnalyticsEventAttribute> Attributes;
+		int64 NumConnections = 0;
+	};
+
+	void ObserveConnections(FOtelObserver& Observer);
+
+	FOtelModule& Module;
+	FOtelWorldTracker& WorldTracker;
+
+	TSharedPtr<FOtelHistogram> HistogramPingMs;
+	TSharedPtr<FOtelHistogram> HistogramInBytes;
+	TSharedPtr<FOtelHistogram> HistogramOutBytes;
+	TSharedPtr<FOtelHistogram> HistogramInPacketLossPct;
+	TSharedPtr<FOtelHistogram> HistogramOutPacketLossPct;
+	TSharedPtr<FOtelObservableInstrument> GaugeConnections;
+
+	// Every server world's connection count as of the last collection, observed from the exporter's thread
+	FOtelUnlockedData<TArray<FWorldConnections>> LatestConnections;
+};
@@ -2,27 +2,13 @@
 
 #include "OtelStats.h"
 #include "Otel.h"
+#include "OtelWorldTracker.h"
 
-#include "GameFramework/PlayerController.h"
-#include "GameFramework/PlayerState.h"
 #include "UObject/UObjectArray.h"
 
-static FString ParseMapName(UWorld* World)
-{
-	check(World);
-
-	FString MapName = World->GetOutermost()->GetName();
-	const int32 PrefixIndex = MapName.Find(World->StreamingLevelsPrefix);
-	if (PrefixIndex != INDEX_NONE)
-	{
-		MapName.RemoveAt(PrefixIndex, World->StreamingLevelsPrefix.Len());
-	}
-	return MapName;
-}
-
-FOtelStats::FOtelStats(FOtelModule& InModule)
+FOtelStats::FOtelStats(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker)
 	: Module(InModule)
-	, NetUpdateTimestamp(0.0)
+	, WorldTracker(InWorldTracker)
 {
 	{
 		FOtelMeter Meter = Module.GetMeter(TEXT("frame_stats"));
@@ -35,72 +21,99 @@ FOtelStats::FOtelStats(FOtelModule& InModule)
 		HistogramRhiMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("frame_stats_rhi_thread"), FrameTimingBuckets, EUnit::Milliseconds);
 		HistogramGpuMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("frame_stats_gpu"), FrameTimingBuckets, EUnit::Milliseconds);
 
-		GaugeMemory = Meter.CreateGauge(EOtelInstrumentType::Int64, TEXT("frame_stats_memory"), EUnit::Megabytes);
-		GaugeMemoryUsedPct = Meter.CreateGauge(EOtelInstrumentType::Double, TEXT("frame_stats_memory_pct_total"));
-		GaugeUObjects = Meter.CreateGauge(EOtelInstrumentType::Int64, TEXT("frame_stats_uobjects"));
-	}
+		// Gauges only need a value once per export, so they're sampled by the exporter instead of every frame
+		GaugeMemory = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("frame_stats_memory"), [this](FOtelObserver& Observer)
+			{
+				const FPlatformMemoryStats& MemStats = GetMemoryStats(0);
+				const uint64 UsedMemoryMB = MemStats.UsedPhysical / (1024 * 1024);
+				Observe(Observer, static_cast<int64>(UsedMemoryMB));
+			}, EUnit::Megabytes);
 
-	{
-		FOtelMeter Meter = Module.GetMeter(TEXT("net_stats"));
+		GaugeMemoryUsedPct = Meter.CreateObservableGauge(EOtelInstrumentType::Double, TEXT("frame_stats_memory_pct_total"), [this](FOtelObserver& Observer)
+			{
+				const FPlatformMemoryStats& MemStats = GetMemoryStats(1);
+				const uint64 UsedMemoryMB = MemStats.UsedPhysical / (1024 * 1024);
+				const uint64 TotalMemoryMB = MemStats.AvailablePhysical / (1024 * 1024);
+				const double MemoryUsedPct = static_cast<double>(UsedMemoryMB) / static_cast<double>(TotalMemoryMB);
+				Observe(Observer, MemoryUsedPct);
+			});
+
+		GaugeUObjects = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("frame_stats_uobjects"), [this](FOtelObserver& Observer)
+			{
+				const int64 NumUObjects = GUObjectArray.GetObjectArrayNum();
+				Observe(Observer, NumUObjects);
+			});
+	}
 
-		const double PingBucketsRaw[] = { 5, 10, 20, 30, 50, 75, 100, 150, 200 };
-		const FOtelHistogramBuckets PingBuckets = FOtelHistogramBuckets::From(PingBucketsRaw);
+	Module.RegisterCollector(this);
+}
 
-		HistogramNetPingMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_ping"), PingBuckets, EUnit::Milliseconds);
+FOtelStats::~FOtelStats()
+{
+	Module.UnregisterCollector(this);
 
-		const uint64 KB = 1024;
-		const uint64 InOutBytesBucketsRaw[] = { 0, KB / 2, KB, KB * 2, KB * 4, KB * 8, KB * 16, KB * 32, KB * 64 };
-		const FOtelHistogramBuckets InOutBytesBuckets = FOtelHistogramBuckets::From(InOutBytesBucketsRaw);
+	// Waits for any in-flight callbacks, which reference this
+	GaugeMemory.Reset();
+	GaugeMemoryUsedPct.Reset();
+	GaugeUObjects.Reset();
+}
 
-		HistogramNetInBytes = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("net_stats_bytes_in"), InOutBytesBuckets, EUnit::Bytes);
-		HistogramNetOutBytes = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("net_stats_bytes_out"), InOutBytesBuckets, EUnit::Bytes);
+template <typename T>
+void FOtelStats::Observe(FOtelObserver& Observer, T Value)
+{
+	TArray<FAnalyticsEventAttribute, TInlineAllocator<1>> Attributes;
+	{
+		FOtelLockedData<FString> MapName = GaugeMapName.Lock();
+		if (!MapName->IsEmpty())
+		{
+			Attributes.Add(FAnalyticsEventAttribute(TEXT("map"), *MapName));
+		}
+	}
 
-		const double PacketLossPctBucketsRaw[] = { 0, 0.05, 0.1, 0.2, 0.3, 0.5, 0.75, 1 };
-		const FOtelHistogramBuckets PacketLossPctBuckets = FOtelHistogramBuckets::From(PacketLossPctBucketsRaw);
+	Observer.Observe(Value, Attributes);
+}
 
-		HistogramNetInPacketLossPct = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_packet_loss_pct_in"), PacketLossPctBuckets);
-		HistogramNetOutPacketLossPct = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("net_stats_packet_loss_pct_out"), PacketLossPctBuckets);
+const FPlatformMemoryStats& FOtelStats::GetMemoryStats(int32 InstrumentIndex)
+{
+	if (MemorySnapshotGate.BeginObserve(InstrumentIndex))
+	{
+		MemorySnapshot = FPlatformMemory::GetStats();
 	}
+	return MemorySnapshot;
 }
 
-TStatId FOtelStats::GetStatId() const
+FName FOtelStats::GetName() const
 {
-	RETURN_QUICK_DECLARE_CYCLE_STAT(FOtelStats, STATGROUP_Tickables);
+	return TEXT("FrameStats");
 }
 
-void FOtelStats::Tick(float DeltaTime)
+FOtelCollectorSettings FOtelStats::GetDefaultSettings() const
 {
-	TArray<FAnalyticsEventAttribute, TInlineAllocator<4>> Attributes;
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 0.0;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
 
-	// Try to pick a client world, but fall back to a server world if no client world is available
-	const TIndirectArray<FWorldContext>& WorldList = GEngine->GetWorldContexts();
-	UWorld* PlayWorld = nullptr;
-	APlayerController* LocalPC = nullptr;
-	for (const FWorldContext& Context : WorldList)
+void FOtelStats::Collect(double DeltaSeconds)
+{
+	// The editor only has frames worth reporting while playing in editor
+	if (GIsEditor && WorldTracker.GetWorlds().IsEmpty())
 	{
-		Attributes.Reset();
+		return;
+	}
 
-		if (Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game)
-		{
-			if (UWorld* World = Context.World())
-			{
-				const bool bRemovePrefixString = true;
-				FString MapName = ParseMapName(World);
-				if (MapName.StartsWith(TEXT("/Game/")))
-				{
-					PlayWorld = World;
-					Attributes.Add(FAnalyticsEventAttribute(TEXT("map"), MapName));
-
-					if (APlayerController* PC = GEngine->GetFirstLocalPlayerController(World))
-					{
-						LocalPC = PC;
-						break;
-					}
-				}
-			}
-		}
+	// Process-wide stats are attributed to the primary world, preferring a client world over a server world
+	FOtelTrackedWorld* PrimaryWorld = WorldTracker.GetPrimaryWorld();
+
+	// The collector scheduler ticks while paused, but paused frames were never part of the frame stats
+	if (PrimaryWorld && PrimaryWorld->World.IsValid() && PrimaryWorld->World->IsPaused())
+	{
+		return;
 	}
 
+	TArrayView<FAnalyticsEventAttribute> Attributes = PrimaryWorld ? TArrayView<FAnalyticsEventAttribute>(PrimaryWorld->Attributes) : TArrayView<FAnalyticsEventAttribute>();
+
 	uint32 EngineGameThreadCycles = 0.0f;
 	if ((GIsEditor == false) && GIsServer)
 	{
@@ -130,44 +143,11 @@ void FOtelStats::Tick(float DeltaTime)
 	HistogramRhiMs->Record(RhiThreadMs, Attributes);
 	HistogramGpuMs->Record(GpuMs, Attributes);
 
-	const FPlatformMemoryStats MemStats = FPlatformMemory::GetStats();
-	const uint64 UsedMemoryMB = MemStats.UsedPhysical / (1024 * 1024);
-	const uint64 TotalMemoryMB = MemStats.AvailablePhysical / (1024 * 1024);
-	const double MemoryUsedPct = static_cast<double>(UsedMemoryMB) / static_cast<double>(TotalMemoryMB);
-
-	GaugeMemory->Observe(static_cast<int64>(UsedMemoryMB), Attributes);
-	GaugeMemoryUsedPct->Observe(MemoryUsedPct, Attributes);
-
-	const int64 NumUObjects = GUObjectArray.GetObjectArrayNum();
-	GaugeUObjects->Observe(NumUObjects, Attributes);
-
-	// determine and record net stats
-	if (PlayWorld && LocalPC)
+	// Hand the current map over to the gauge callbacks
+	const bool bMapChanged = PrimaryWorld ? (PrimaryWorld->MapName != LastMapName) : (LastMapName.IsEmpty() == false);
+	if (bMapChanged)
 	{
-		if (APlayerState* PS = LocalPC->GetPlayerState<APlayerState>())
-		{
-			double PingMs = PS->GetPingInMilliseconds();
-			HistogramNetPingMs->Record(PingMs, Attributes);
-		}
-
-		if (UNetConnection* NetConnection = LocalPC->GetNetConnection())
-		{
-			const double Now = FPlatformTime::Seconds();
-			const double TimeSinceLastUpdate = Now - NetUpdateTimestamp;
-			if (TimeSinceLastUpdate >= NetConnection->StatPeriod)
-			{
-				NetUpdateTimestamp = Now;
-
-				const uint64 InBytes = static_cast<uint64>(FMath::Max(0, NetConnection->InBytes));
-				const uint64 OutBytes = static_cast<uint64>(FMath::Max(0, NetConnection->OutBytes));
-				const double InPacketLossPct = NetConnection->GetInLossPercentage().GetLossPercentage();
-				const double OutPacketLossPct = NetConnection->GetOutLossPercentage().GetLossPercentage();
-
-				HistogramNetInBytes->Record(InBytes, Attributes);
-				HistogramNetOutBytes->Record(OutBytes, Attributes);
-				HistogramNetInPacketLossPct->Record(InPacketLossPct, Attributes);
-				HistogramNetOutPacketLossPct->Record(OutPacketLossPct, Attributes);
-			}
-		}
+		LastMapName = PrimaryWorld ? PrimaryWorld->MapName : FString();
+		*GaugeMapName.Lock() = LastMapName;
 	}
 }
@@ -2,37 +2,46 @@
 
 #pragma once
 
-#include "Tickable.h"
+#include "Otel.h"
 
-class FOtelModule;
-struct FOtelHistogram;
-struct FOtelGauge;
+class FOtelWorldTracker;
 
-class FOtelStats : public FTickableGameObject
+// Records frame timings every frame, and reports memory and UObject gauges when metrics are exported.
+class FOtelStats : public IOtelCollector
 {
 public:
-	FOtelStats(FOtelModule& InModule);
+	FOtelStats(FOtelModule& InModule, FOtelWorldTracker& InWorldTracker);
+	~FOtelStats();
 
-	// FTickableGameObject
-	virtual TStatId GetStatId() const override;
-	virtual void Tick(float DeltaTime) override;
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
 
 private:
+	template <typename T>
+	void Observe(FOtelObserver& Observer, T Value);
+
+	// Both memory gauges report from one FPlatformMemory::GetStats() call per collection
+	const FPlatformMemoryStats& GetMemoryStats(int32 InstrumentIndex);
+
 	FOtelModule& Module;
+	FOtelWorldTracker& WorldTracker;
 
 	TSharedPtr<FOtelHistogram> HistogramGameMs;
 	TSharedPtr<FOtelHistogram> HistogramRenderMs;
 	TSharedPtr<FOtelHistogram> HistogramRhiMs;
 	TSharedPtr<FOtelHistogram> HistogramGpuMs;
-	TSharedPtr<FOtelGauge> GaugeMemory;
-	TSharedPtr<FOtelGauge> GaugeMemoryUsedPct;
-	TSharedPtr<FOtelGauge> GaugeUObjects;
-
-	TSharedPtr<FOtelHistogram> HistogramNetPingMs;
-	TSharedPtr<FOtelHistogram> HistogramNetInBytes;
-	TSharedPtr<FOtelHistogram> HistogramNetOutBytes;
-	TSharedPtr<FOtelHistogram> HistogramNetInPacketLossPct;
-	TSharedPtr<FOtelHistogram> HistogramNetOutPacketLossPct;
-
-	double NetUpdateTimestamp;
+	TSharedPtr<FOtelObservableInstrument> GaugeMemory;
+	TSharedPtr<FOtelObservableInstrument> GaugeMemoryUsedPct;
+	TSharedPtr<FOtelObservableInstrument> GaugeUObjects;
+
+	// Map of the current play world, which is read by the gauge callbacks on the exporter thread. Only updated when the
+	// map changes.
+	FOtelUnlockedData<FString> GaugeMapName;
+	FString LastMapName;
+
+	// Only accessed by the memory gauge callbacks
+	FOtelSnapshotGate MemorySnapshotGate;
+	FPlatformMemoryStats MemorySnapshot;
 };
@@ -0,0 +1,197 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelTaskStats.h"
+#include "OtelProcStats.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/Fundamental/Scheduler.h"
+
+// Linux truncates thread names to 15 characters, which cuts "Foreground Worker #N" down to this
+static const ANSICHAR* ForegroundWorkerPrefix = "Foreground Work";
+static const ANSICHAR* BackgroundWorkerPrefix = "Background Work";
+
+FOtelTaskStats::FOtelTaskStats(FOtelModule& InModule, FOtelProcStats& InProcStats)
+	: Module(InModule)
+	, ProcStats(InProcStats)
+{
+	struct FPriorityDesc
+	{
+		UE::Tasks::ETaskPriority Priority;
+		const TCHAR* Name;
+		const TCHAR* Pool;
+	};
+
+	const FPriorityDesc Priorities[] = {
+		{ UE::Tasks::ETaskPriority::High, TEXT("high"), TEXT("foreground") },
+		{ UE::Tasks::ETaskPriority::Normal, TEXT("normal"), TEXT("foreground") },
+		{ UE::Tasks::ETaskPriority::BackgroundHigh, TEXT("background_high"), TEXT("background") },
+		{ UE::Tasks::ETaskPriority::BackgroundNormal, TEXT("background_normal"), TEXT("background") },
+		{ UE::Tasks::ETaskPriority::BackgroundLow, TEXT("background_low"), TEXT("background") },
+	};
+
+	for (const FPriorityDesc& Desc : Priorities)
+	{
+		FProbe& Probe = Probes.AddDefaulted_GetRef();
+		Probe.Priority = Desc.Priority;
+		Probe.Attributes.Add(FAnalyticsEventAttribute(TEXT("pool"), Desc.Pool));
+		Probe.Attributes.Add(FAnalyticsEventAttribute(TEXT("priority"), Desc.Name));
+	}
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("task_stats"));
+
+	const double WaitBucketsRaw[] = { 0.01, 0.05, 0.1, 0.25, 0.5, 1, 2, 5, 10, 25, 50, 100 };
+	const FOtelHistogramBuckets WaitBuckets = FOtelHistogramBuckets::From(WaitBucketsRaw);
+	HistogramWaitMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("task_stats_wait_latency"), WaitBuckets, EUnit::Milliseconds);
+
+	const double UtilizationBucketsRaw[] = { 0.05, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 1 };
+	const FOtelHistogramBuckets UtilizationBuckets = FOtelHistogramBuckets::From(UtilizationBucketsRaw);
+	HistogramWorkerUtilization = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("task_stats_worker_utilization"), UtilizationBuckets);
+	CounterWorkerBusySeconds = Meter.CreateCounter(EOtelInstrumentType::Double, TEXT("task_stats_worker_busy_time"), EUnit::Seconds);
+	CounterWorkerIdleSeconds = Meter.CreateCounter(EOtelInstrumentType::Double, TEXT("task_stats_worker_idle_time"), EUnit::Seconds);
+
+	GaugeWorkers = Meter.CreateObservableGauge(EOtelInstrumentType::Int64, TEXT("task_stats_workers"), [](FOtelObserver& Observer)
+		{
+			Observer.Observe(static_cast<int64>(LowLevelTasks::FScheduler::Get().GetNumWorkers()), {});
+		});
+
+	Module.RegisterCollector(this);
+}
+
+FOtelTaskStats::~FOtelTaskStats()
+{
+	Module.UnregisterCollector(this);
+
+	// Probes reference this, so they have to finish first
+	for (FProbe& Probe : Probes)
+	{
+		if (Probe.Task.IsValid())
+		{
+			Probe.Task.Wait();
+		}
+	}
+
+	GaugeWorkers.Reset();
+}
+
+FName FOtelTaskStats::GetName() const
+{
+	return TEXT("TaskStats");
+}
+
+FOtelCollectorSettings FOtelTaskStats::GetDefaultSettings() const
+{
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 1.0;
+	Settings.Thread = EOtelCollectorThread::AnyThread;
+	return Settings;
+}
+
+void FOtelTaskStats::Collect(double DeltaSeconds)
+{
+	LaunchProbes();
+	RecordWorkerUtilization();
+}
+
+void FOtelTaskStats::LaunchProbes()
+{
+	for (FProbe& Probe : Probes)
+	{
+		// A probe that hasn't run since the last collection already says everything there is to say about that priority
+		if (Probe.Task.IsValid() && Probe.Task.IsCompleted() == false)
+		{
+			continue;
+		}
+
+		const uint64 LaunchCycles = FPlatformTime::Cycles64();
+		FOtelHistogram* Histogram = HistogramWaitMs.Get();
+		TArrayView<FAnalyticsEventAttribute> Attributes = Probe.Attributes;
+		Probe.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Histogram, Attributes, LaunchCycles]()
+			{
+				const double WaitMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - LaunchCycles);
+				Histogram->Record(WaitMs, Attributes);
+			},
+			Probe.Priority);
+	}
+}
+
+void FOtelTaskStats::RecordWorkerUtilization()
+{
+	Swap(Workers, PreviousWorkers);
+	Workers.Reset();
+
+	ProcStats.VisitThreadCpuTime([this](int32 Tid, const ANSICHAR* Name, double CpuSeconds)
+		{
+			const bool bForeground = FCStringAnsi::Strncmp(Name, ForegroundWorkerPrefix, FCStringAnsi::Strlen(ForegroundWorkerPrefix)) == 0;
+			const bool bBackground = FCStringAnsi::Strncmp(Name, BackgroundWorkerPrefix, FCStringAnsi::Strlen(BackgroundWorkerPrefix)) == 0;
+			if (bForeground || bBackground)
+			{
+				FWorkerSample& Sample = Workers.AddDefaulted_GetRef();
+				Sample.Tid = Tid;
+				Sample.CpuSeconds = CpuSeconds;
+				Sample.bForeground = bForeground;
+			}
+		});
+
+	Workers.Sort([](const FWorkerSample& A, const FWorkerSample& B)
+		{
+			return A.Tid < B.Tid;
+		});
+
+	// Measured rather than taken from the collection interval, which is only what was asked for
+	const double NowSeconds = FPlatformTime::Seconds();
+	const double ElapsedSeconds = NowSeconds - LastWorkerSampleSeconds;
+	const bool bHasPrevious = LastWorkerSampleSeconds > 0.0;
+	LastWorkerSampleSeconds = NowSeconds;
+
+	if (bHasPrevious == false || ElapsedSeconds <= 0.0)
+	{
+		return;
+	}
+
+	double ForegroundBusySeconds = 0.0;
+	double BackgroundBusySeconds = 0.0;
+	int32 NumForegroundWorkers = 0;
+	int32 NumBackgroundWorkers = 0;
+
+	FAnalyticsEventAttribute ForegroundAttributes[] = { FAnalyticsEventAttribute(TEXT("pool"), TEXT("foreground")) };
+	FAnalyticsEventAttribute BackgroundAttributes[] = { FAnalyticsEventAttribute(TEXT("pool"), TEXT("background")) };
+
+	for (const FWorkerSample& Worker : Workers)
+	{
+		// Workers that started since the last collection weren't around for all of it, so they wait for the next one
+		const int32 PreviousIndex = Algo::BinarySearchBy(PreviousWorkers, Worker.Tid, &FWorkerSample::Tid);
+		if (PreviousIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// CPU time is counted in scheduler ticks, so a fully busy thread can come out slightly over the elapsed time
+		const double BusySeconds = FMath::Clamp(Worker.CpuSeconds - PreviousWorkers[PreviousIndex].CpuSeconds, 0.0, ElapsedSeconds);
+		const double Utilization = BusySeconds / ElapsedSeconds;
+
+		if (Worker.bForeground)
+		{
+			HistogramWorkerUtilization->Record(Utilization, ForegroundAttributes);
+			ForegroundBusySeconds += BusySeconds;
+			++NumForegroundWorkers;
+		}
+		else
+		{
+			HistogramWorkerUtilization->Record(Utilization, BackgroundAttributes);
+			BackgroundBusySeconds += BusySeconds;
+			++NumBackgroundWorkers;
+		}
+	}
+
+	if (NumForegroundWorkers > 0)
+	{
+		CounterWorkerBusySeconds->Add(ForegroundBusySeconds, ForegroundAttributes);
+		CounterWorkerIdleSeconds->Add(NumForegroundWorkers * ElapsedSeconds - ForegroundBusySeconds, ForegroundAttributes);
+	}
+
+	if (NumBackgroundWorkers > 0)
+	{
+		CounterWorkerBusySeconds->Add(BackgroundBusySeconds, BackgroundAttributes);
+		CounterWorkerIdleSeconds->Add(NumBackgroundWorkers * ElapsedSeconds - BackgroundBusySeconds, BackgroundAttributes);
+	}
+}
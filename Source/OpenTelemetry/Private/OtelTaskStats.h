@@ -0,0 +1,58 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+#include "Tasks/Task.h"
+
+class FOtelProcStats;
+
+// Measures how saturated the task system's worker pools are. Once per collection a no-op probe task is launched at each
+// task priority, and the time until it starts running is recorded as the wait latency of that priority. On Linux, the
+// busy and idle time of each foreground and background worker thread is also derived from the change in its CPU time
+// between collections. The scheduler doesn't expose its queues, so probe latency stands in for queue depth.
+class FOtelTaskStats : public IOtelCollector
+{
+public:
+	FOtelTaskStats(FOtelModule& InModule, FOtelProcStats& InProcStats);
+	~FOtelTaskStats();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	void LaunchProbes();
+	void RecordWorkerUtilization();
+
+	struct FProbe
+	{
+		UE::Tasks::ETaskPriority Priority;
+		TArray<FAnalyticsEventAttribute> Attributes;
+		UE::Tasks::FTask Task;
+	};
+
+	struct FWorkerSample
+	{
+		int32 Tid = 0;
+		double CpuSeconds = 0.0;
+		bool bForeground = false;
+	};
+
+	FOtelModule& Module;
+	FOtelProcStats& ProcStats;
+
+	TArray<FProbe> Probes;
+
+	// Worker CPU time at the last collection, sorted by thread id
+	TArray<FWorkerSample> Workers;
+	TArray<FWorkerSample> PreviousWorkers;
+	double LastWorkerSampleSeconds = 0.0;
+
+	TSharedPtr<FOtelHistogram> HistogramWaitMs;
+	TSharedPtr<FOtelHistogram> HistogramWorkerUtilization;
+	TSharedPtr<FOtelCounter> CounterWorkerBusySeconds;
+	TSharedPtr<FOtelCounter> CounterWorkerIdleSeconds;
+	TSharedPtr<FOtelObservableInstrument> GaugeWorkers;
+};
@@ -0,0 +1,137 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelWorldTracker.h"
+
+#include "Engine/Engine.h"
+#include "UObject/Package.h"
+
+FString ParseMapName(UWorld* World)
+{
+	check(World);
+
+	FString MapName = World->GetOutermost()->GetName();
+	const int32 PrefixIndex = MapName.Find(World->StreamingLevelsPrefix);
+	if (PrefixIndex != INDEX_NONE)
+	{
+		MapName.RemoveAt(PrefixIndex, World->StreamingLevelsPrefix.Len());
+	}
+	return MapName;
+}
+
+static bool IsTrackedWorldType(const UWorld* World)
+{
+	return World && (World->WorldType == EWorldType::PIE || World->WorldType == EWorldType::Game);
+}
+
+FOtelWorldTracker::FOtelWorldTracker()
+{
+	PostWorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FOtelWorldTracker::OnPostWorldInitialization);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FOtelWorldTracker::OnWorldCleanup);
+	PostLoadMapWithWorldHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FOtelWorldTracker::OnPostLoadMapWithWorld);
+
+	// Pick up any worlds that were created before the plugin was loaded
+	if (GEngine)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if (IsTrackedWorldType(Context.World()))
+			{
+				AddOrUpdateWorld(Context.World());
+			}
+		}
+	}
+}
+
+FOtelWorldTracker::~FOtelWorldTracker()
+{
+	FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapWithWorldHandle);
+}
+
+FOtelTrackedWorld* FOtelWorldTracker::GetPrimaryWorld()
+{
+	if (Worlds.IsValidIndex(PrimaryWorldIndex) && Worlds[PrimaryWorldIndex].World.IsValid())
+	{
+		return &Worlds[PrimaryWorldIndex];
+	}
+	return nullptr;
+}
+
+void FOtelWorldTracker::UpdatePrimaryWorld()
+{
+	PrimaryWorldIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Worlds.Num(); ++Index)
+	{
+		const FOtelTrackedWorld& Tracked = Worlds[Index];
+		UWorld* World = Tracked.World.Get();
+		if (World == nullptr || Tracked.MapName.StartsWith(TEXT("/Game/")) == false)
+		{
+			continue;
+		}
+
+		// Clients have local players, so they're preferred over servers
+		if (World->GetNetMode() != NM_DedicatedServer)
+		{
+			PrimaryWorldIndex = Index;
+			return;
+		}
+
+		if (PrimaryWorldIndex == INDEX_NONE)
+		{
+			PrimaryWorldIndex = Index;
+		}
+	}
+}
+
+void FOtelWorldTracker::OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+	if (IsTrackedWorldType(World))
+	{
+		AddOrUpdateWorld(World);
+	}
+}
+
+void FOtelWorldTracker::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	Worlds.RemoveAll([World](const FOtelTrackedWorld& Tracked)
+		{
+			return Tracked.World.Get() == World || Tracked.World.IsValid() == false;
+		});
+	UpdatePrimaryWorld();
+}
+
+void FOtelWorldTracker::OnPostLoadMapWithWorld(UWorld* World)
+{
+	// Covers worlds that are renamed or travel without being reinitialized
+	if (IsTrackedWorldType(World))
+	{
+		AddOrUpdateWorld(World);
+	}
+}
+
+void FOtelWorldTracker::AddOrUpdateWorld(UWorld* World)
+{
+	FOtelTrackedWorld* Tracked = Worlds.FindByPredicate([World](const FOtelTrackedWorld& Tracked)
+		{
+			return Tracked.World.Get() == World;
+		});
+
+	if (Tracked == nullptr)
+	{
+		Tracked = &Worlds.AddDefaulted_GetRef();
+		Tracked->World = World;
+	}
+
+	Tracked->MapName = ParseMapName(World);
+	Tracked->Attributes.Reset();
+	Tracked->Attributes.Add(FAnalyticsEventAttribute(TEXT("map"), Tracked->MapName));
+
+	const int32 PIEInstance = World->GetOutermost()->GetPIEInstanceID();
+	if (World->WorldType == EWorldType::PIE && PIEInstance != INDEX_NONE)
+	{
+		Tracked->Attributes.Add(FAnalyticsEventAttribute(TEXT("pie_instance"), PIEInstance));
+	}
+
+	UpdatePrimaryWorld();
+}
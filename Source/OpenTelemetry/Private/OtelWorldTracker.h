@@ -0,0 +1,50 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "AnalyticsEventAttribute.h"
+#include "Engine/World.h"
+#include "UObject/WeakObjectPtr.h"
+
+// Package name of the world with the streaming level prefix removed, e.g. /Game/Maps/MyMap
+FString ParseMapName(UWorld* World);
+
+struct FOtelTrackedWorld
+{
+	TWeakObjectPtr<UWorld> World;
+	FString MapName;
+
+	// Attributes identifying this world's series: the map, plus the PIE instance when running multiple PIE clients
+	TArray<FAnalyticsEventAttribute> Attributes;
+};
+
+// Keeps the set of game and PIE worlds, along with their metric attributes, up to date from the world lifecycle
+// delegates, so collectors don't have to walk the world contexts and rebuild attributes every tick. Game thread only.
+class FOtelWorldTracker
+{
+public:
+	FOtelWorldTracker();
+	~FOtelWorldTracker();
+
+	TArrayView<FOtelTrackedWorld> GetWorlds() { return Worlds; }
+
+	// The world whose attributes describe process-wide stats (e.g. frame times): the first world with a game map that
+	// isn't a dedicated server, falling back to any world with a game map. Worked out as worlds come and go, so it's
+	// cheap to call every frame.
+	FOtelTrackedWorld* GetPrimaryWorld();
+
+private:
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void OnPostLoadMapWithWorld(UWorld* World);
+
+	void AddOrUpdateWorld(UWorld* World);
+	void UpdatePrimaryWorld();
+
+	TArray<FOtelTrackedWorld> Worlds;
+	int32 PrimaryWorldIndex = INDEX_NONE;
+
+	FDelegateHandle PostWorldInitializationHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle PostLoadMapWithWorldHandle;
+};
@@ -48,7 +48,26 @@ namespace otel = opentelemetry::v1;
 
 struct FOtelScopedSpanImpl;
 class FOtelStats;
+class FOtelNetStats;
+class FOtelFramePacing;
+class FOtelWorldTracker;
+class FOtelCollectorScheduler;
+class FOtelOverhead;
+class FOtelBudget;
+class FOtelBudgetState;
+class FOtelCsvStats;
+class FOtelEngineStats;
+class FOtelLlmStats;
+class FOtelProcStats;
+class FOtelTaskStats;
+class FOtelGcStats;
+class FOtelLoadStats;
+class FOtelServerNetStats;
+class FOtelReplicationStats;
+class FOtelModuleLoadStats;
+class FOtelCommandletTracing;
 class FOtelModule;
+class UClass;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Utilities
@@ -82,6 +101,32 @@ private:
 	FCriticalSection Mutex;
 };
 
+// Lets several observable instruments report the same snapshot within one metrics collection. An instrument observing
+// again means a new collection has started, however soon after the last one (e.g. a forced flush), so that is when the
+// snapshot has to be retaken. Observe callbacks run on the exporter thread, so this isn't locked.
+class FOtelSnapshotGate
+{
+public:
+	// Called at the start of instrument InstrumentIndex's (0-63) observe callback. Returns true if the snapshot needs
+	// to be retaken before it's reported.
+	bool BeginObserve(int32 InstrumentIndex)
+	{
+		const uint64 InstrumentBit = 1ull << InstrumentIndex;
+		const bool bNewCollection = bHasSnapshot == false || (ObservedInstruments & InstrumentBit) != 0;
+		if (bNewCollection)
+		{
+			ObservedInstruments = 0;
+			bHasSnapshot = true;
+		}
+		ObservedInstruments |= InstrumentBit;
+		return bNewCollection;
+	}
+
+private:
+	uint64 ObservedInstruments = 0;
+	bool bHasSnapshot = false;
+};
+
 class FOtelOutputDevice : public FOutputDevice
 {
 public:
@@ -124,6 +169,12 @@ struct OPENTELEMETRY_API FOtelSpan
 {
 	FOtelSpan();
 	FOtelSpan(FName InTracerName, std::shared_ptr<otel::trace::Span> InOtelSpan);
+	FOtelSpan(const FOtelSpan& Span) = default;
+	FOtelSpan(FOtelSpan&& Span) = default;
+	~FOtelSpan();
+
+	FOtelSpan& operator=(const FOtelSpan& Span) = default;
+	FOtelSpan& operator=(FOtelSpan&& Span) = default;
 
 	void SetStatus(EOtelStatus Status);
 	void AddAttribute(const FAnalyticsEventAttribute& Attribute);
@@ -131,6 +182,10 @@ struct OPENTELEMETRY_API FOtelSpan
 	void AddEvent(const TCHAR* Name, TArrayView<const FAnalyticsEventAttribute> Attributes);
 	FString TraceId() const;
 
+	// Spans end on their own when the last FOtelSpan referencing them goes away. Use this to end one earlier, or at a
+	// timestamp in the past for spans built retroactively. Don't use it on the inner span of an FOtelScopedSpan.
+	void End(const FOtelTimestamp* OptionalTimestamp = nullptr);
+
 	FName TracerName;
 	std::shared_ptr<otel::trace::Span> OtelSpan;
 
@@ -178,7 +233,8 @@ struct FOtelCounter
 	virtual void Add(double Value, TArrayView<FAnalyticsEventAttribute> Attributes) = 0;
 };
 
-// Records whatever the value was when the otel libs perform a collection for export to the backend.
+// Records whatever the value was when the otel libs perform a collection for export to the backend. Prefer
+// FOtelMeter::CreateObservableGauge() for values that are expensive to compute, since only the last one is reported.
 struct FOtelGauge
 {
 	virtual ~FOtelGauge() = default;
@@ -194,6 +250,29 @@ struct FOtelHistogram
 	virtual void Record(double Value, TArrayView<FAnalyticsEventAttribute> Attributes) = 0;
 };
 
+// Passed to observable instrument callbacks to report the value of one or more series at collection time.
+struct FOtelObserver
+{
+	virtual ~FOtelObserver() = default;
+	virtual void Observe(int64 Value, TArrayView<const FAnalyticsEventAttribute> Attributes) = 0;
+	virtual void Observe(double Value, TArrayView<const FAnalyticsEventAttribute> Attributes) = 0;
+};
+
+// Observable instrument callbacks are invoked by the otel libs on the metric exporter's background thread, once per
+// export interval. This means callbacks:
+// * must only read state that is safe to read from any thread. Snapshot game-thread-only state (e.g. UObjects) into
+//   locked data on the game thread instead, see FOtelUnlockedData.
+// * must not create or destroy observable instruments, since the otel libs hold their callback lock while collecting.
+// * should be cheap, since they delay the collection of every other instrument.
+using FOtelObserveCallback = TFunction<void(FOtelObserver& Observer)>;
+
+// Keeps the callback of an observable instrument registered for as long as it's alive. Destroying it blocks until any
+// in-flight invocation of the callback has finished, so whatever the callback reads can safely be released afterwards.
+struct FOtelObservableInstrument
+{
+	virtual ~FOtelObservableInstrument() = default;
+};
+
 enum EOtelInstrumentType
 {
 	Int64,
@@ -219,6 +298,14 @@ struct OPENTELEMETRY_API FOtelMeter
 	// Reports the last-observed value at the time of export.
 	TSharedPtr<FOtelGauge> CreateGauge(EOtelInstrumentType MeterType, const TCHAR* GaugeName, EUnit UnitType = EUnit::Unspecified);
 
+	// Monotonically-increasing counter whose running total is reported by Callback at collection time. See
+	// CreateObservableGauge().
+	TSharedPtr<FOtelObservableInstrument> CreateObservableCounter(EOtelInstrumentType MeterType, const TCHAR* CounterName, FOtelObserveCallback Callback, EUnit UnitType = EUnit::Unspecified);
+
+	// Calls Callback whenever the otel libs perform a collection for export, which happens on the exporter's background
+	// thread. Unlike CreateGauge(), the callback can observe any number of series.
+	TSharedPtr<FOtelObservableInstrument> CreateObservableGauge(EOtelInstrumentType MeterType, const TCHAR* GaugeName, FOtelObserveCallback Callback, EUnit UnitType = EUnit::Unspecified);
+
 	// Aggregates recorded values into buckets and reports the bucket count.
 	TSharedPtr<FOtelHistogram> CreateHistogram(EOtelInstrumentType MeterType, const TCHAR* HistogramName, FOtelHistogramBuckets Buckets, EUnit UnitType = EUnit::Unspecified);
 
@@ -227,6 +314,40 @@ struct OPENTELEMETRY_API FOtelMeter
 	std::shared_ptr<otel::metrics::Meter> OtelMeter;
 };
 
+enum class EOtelCollectorThread
+{
+	// Collect() is called on the game thread, so it can read UObjects and other game state
+	GameThread,
+
+	// Collect() is launched as a task on a worker thread. The next collection is skipped if it's still running.
+	AnyThread,
+};
+
+struct FOtelCollectorSettings
+{
+	// How often Collect() is called. 0 calls it every frame.
+	double IntervalSeconds = 0.0;
+	EOtelCollectorThread Thread = EOtelCollectorThread::GameThread;
+	bool bEnabled = true;
+};
+
+// Something that samples telemetry on a schedule, see FOtelModule::RegisterCollector(). The settings returned by
+// GetDefaultSettings() can be overridden from the <Target>.Collectors section of DefaultOtel.ini with
+// <Name>.bEnabled and <Name>.IntervalMs keys, and collectors can be toggled at runtime with the
+// otel.Collector.<Name> console variable.
+class IOtelCollector
+{
+public:
+	virtual ~IOtelCollector() = default;
+
+	// Must be unique, and is used for the ini keys and console variable
+	virtual FName GetName() const = 0;
+	virtual FOtelCollectorSettings GetDefaultSettings() const = 0;
+
+	// DeltaSeconds is the time since the previous call
+	virtual void Collect(double DeltaSeconds) = 0;
+};
+
 // Configuration values read out of DefaultOtel.ini. See the example provided in the plugin Config/.
 struct FOtelSpanConfig
 {
@@ -259,6 +380,93 @@ struct FOtelLogConfig
 	bool bUseSsl = true;
 };
 
+struct FOtelStatsConfig
+{
+	// CSV profiler categories to enable and export as histograms when a capture finishes. Use "Default" for stats
+	// that aren't in a named category.
+	TArray<FString> CsvCategories;
+
+	// Opt-in: length of the rolling CSV captures started while no other capture is running. These keep the CSV
+	// profiler recording and write a file per capture, and a capture requested while one is running has to wait for
+	// it to end. 0 only exports captures started by something else.
+	int32 CsvCaptureFrames = 0;
+
+	// Engine stats (e.g. STAT_GameEngineTick) and stat groups (e.g. Engine for STATGROUP_Engine) to export. Cycle
+	// counters are exported as histograms, everything else as gauges. Configured groups are enabled on startup.
+	TArray<FString> EngineStats;
+	TArray<FString> EngineStatGroups;
+
+	// When LLM is enabled, the largest tags are exported as one gauge series each. The remaining tags are summed into
+	// an "Other" series. Set to 0 to disable.
+	int32 LlmTopTags = 20;
+
+	// Synchronous package loads that take at least this long get a span. With editor-only data, packages at least
+	// LoadSpanThresholdBytes large do too. Set the byte threshold to 0 to only sample by duration.
+	int32 LoadSpanThresholdMs = 50;
+	int64 LoadSpanThresholdBytes = 0;
+
+	// Opt-in: when greater than 0, replication costs recorded with OTEL_RECORD_REPLICATION are reported for this many of
+	// the most expensive actor classes each export interval. Records past the per-frame budget are dropped.
+	int32 ReplicationTopClasses = 0;
+	int32 ReplicationMaxRecordsPerFrame = 4096;
+
+	// Frame pacing reports how many frames, and how much time, went over this budget. Set to 0 to disable.
+	float FrameBudgetMs = 0.0f;
+
+	// A frame counts as a stutter at each threshold that it exceeds the average of the last few frames by
+	TArray<FString> StutterThresholdsMs;
+
+	// Modules that take at least this long to load during startup get a span under their loading phase. Faster ones
+	// are only counted in the phase totals and the load time histogram.
+	int32 ModuleLoadSpanThresholdMs = 10;
+
+	// Cook commandlets trace packages that take at least this long to save, up to CookMaxPackageSpans per cook. Every
+	// package is counted in the package time histogram regardless. Set the threshold to 0 to disable package spans.
+	int32 CookPackageSpanThresholdMs = 250;
+	int32 CookMaxPackageSpans = 2000;
+
+	// Opt-in: when greater than 0, blueprint compiles and package saves in the editor are timed into histograms, and
+	// those that take at least this long get a span
+	int32 EditorAssetSpanThresholdMs = 0;
+
+	// Editor frames that take at least this long count as hitches and get a span. Set to 0 to disable hitch spans.
+	int32 EditorHitchThresholdMs = 250;
+
+	// Modal slow tasks (FScopedSlowTask) that take at least this long get a span, along with any tasks nested in them
+	// that also took this long. Set to 0 to disable slow task spans.
+	int32 SlowTaskSpanThresholdMs = 1000;
+};
+
+struct FOtelCollectorConfig
+{
+	TOptional<bool> bEnabled;
+	TOptional<int32> IntervalMs;
+};
+
+struct FOtelCollectorsConfig
+{
+	// Collectors with an interval are spread over frames so no more than this many run on a single frame. Collectors
+	// that run every frame don't count towards the limit.
+	int32 MaxCollectionsPerFrame = 4;
+
+	// Overrides of IOtelCollector::GetDefaultSettings(), by collector name
+	TMap<FName, FOtelCollectorConfig> Overrides;
+};
+
+struct FOtelBudgetConfig
+{
+	// Telemetry's own CPU cost per frame on the game thread, before span events, traces and logs are throttled. Work on
+	// exporter and worker threads doesn't hold up the frame, so it doesn't count. Set to 0 to ignore the overhead.
+	float FrameBudgetMs = 0.0f;
+
+	// How full the span and log export queues can get, from 0 to 1, before they're throttled. Set to 0 to ignore the
+	// queues. The budget is disabled when both this and FrameBudgetMs are 0.
+	float MaxQueueFill = 0.0f;
+
+	// Throttled rates never go below this, so some data always makes it through. Values under 0.001 are raised to it.
+	float MinRate = 0.01f;
+};
+
 struct FOtelConfig
 {
 	static FOtelConfig LoadFromIni();
@@ -266,6 +474,9 @@ struct FOtelConfig
 	FOtelSpanConfig Trace;
 	FOtelMetricConfig Metric;
 	FOtelLogConfig Log;
+	FOtelStatsConfig Stats;
+	FOtelCollectorsConfig Collectors;
+	FOtelBudgetConfig Budget;
 };
 
 // Emits all logs from the supplied category as span events, for the lifetime of the struct. If you want the hooks to
@@ -328,6 +539,30 @@ public:
 
 	void ForceFlush(double TimeoutSeconds, const FName TracerName = NAME_None);
 
+	// Accounts replication cost to an actor class. Meant to be called by net drivers or replication graphs once per
+	// replicated actor, see OTEL_RECORD_REPLICATION. Does nothing unless FOtelStatsConfig::ReplicationTopClasses is set.
+	void RecordReplication(const UClass* ActorClass, uint32 NumBytes, uint32 CompareCycles);
+
+	const FOtelConfig& GetConfig() const { return Config; }
+
+	// When running a commandlet, the root span covering the whole run. Use it as the parent of spans that should be
+	// grouped under the run. Otherwise the span is empty, and spans parented to it start new traces.
+	FOtelSpan GetCommandletSpan() const;
+
+	// Records a commandlet's exit code on the commandlet span, which gets an error status if it isn't 0. The engine keeps
+	// the value a commandlet returns from Main() to itself, so commandlets that want it traced call this before returning.
+	void SetCommandletExitCode(int32 ExitCode);
+
+	// The root span of the editor's startup timeline, set by the editor module while the editor starts up so that module
+	// loading phases are traced under it. Otherwise the span is empty, and the phases start traces of their own.
+	FOtelSpan GetStartupSpan() const { return StartupSpan; }
+	void SetStartupSpan(const FOtelSpan& Span) { StartupSpan = Span; }
+
+	// Schedules Collector according to its settings until it's unregistered. Ownership stays with the caller, which must
+	// unregister the collector before destroying it. Unregistering waits for any in-flight AnyThread collection.
+	void RegisterCollector(IOtelCollector* Collector);
+	void UnregisterCollector(IOtelCollector* Collector);
+
 private:
 	void LazyCreateLogHook();
 
@@ -341,8 +576,28 @@ private:
 	std::shared_ptr<otel::sdk::metrics::MeterProvider> MeterProvider;
 	std::shared_ptr<otel::sdk::logs::LoggerProvider> LoggerProvider;
 
+	TSharedPtr<FOtelBudgetState> BudgetState;
+	FOtelOverhead* Overhead = nullptr;
+	FOtelBudget* Budget = nullptr;
+	FOtelCollectorScheduler* CollectorScheduler = nullptr;
+	FOtelWorldTracker* WorldTracker = nullptr;
 	FOtelStats* FrameStats = nullptr;
-
+	FOtelNetStats* NetStats = nullptr;
+	FOtelFramePacing* FramePacing = nullptr;
+	FOtelCsvStats* CsvStats = nullptr;
+	FOtelEngineStats* EngineStats = nullptr;
+	FOtelLlmStats* LlmStats = nullptr;
+	FOtelProcStats* ProcStats = nullptr;
+	FOtelTaskStats* TaskStats = nullptr;
+	FOtelGcStats* GcStats = nullptr;
+	FOtelLoadStats* LoadStats = nullptr;
+	FOtelServerNetStats* ServerNetStats = nullptr;
+	FOtelReplicationStats* ReplicationStats = nullptr;
+	FOtelModuleLoadStats* ModuleLoadStats = nullptr;
+	FOtelCommandletTracing* CommandletTracing = nullptr;
+	FOtelSpan StartupSpan;
+
+	friend struct FOtelSpan;
 	friend struct FOtelScopedSpan;
 	friend struct FOtelScopedSpanImpl;
 	friend struct FOtelTracer;
@@ -378,6 +633,11 @@ private:
 #define OTEL_TRACER_LOG_ERROR(TracerName, Message, Attributes) \
 	FOtelModule::Get().EmitLog(Message, Attributes, TEXT(__FILE__), __LINE__, TracerName, EOtelStatus::Error)
 
+// Accounts the bytes written and property compare time (in FPlatformTime::Cycles()) of replicating one actor to its
+// class. See FOtelModule::RecordReplication().
+#define OTEL_RECORD_REPLICATION(ActorClass, NumBytes, CompareCycles) \
+	FOtelModule::Get().RecordReplication(ActorClass, NumBytes, CompareCycles)
+
 // Use this to capture all logs within the current scope. See FOtelScopedLogHook for more details.
 #define OTEL_SCOPED_LOG_HOOK(LogCategory, LogVerbosity) \
 	FOtelScopedLogHook PREPROCESSOR_JOIN(OtelLogHook, __LINE__) = FOtelScopedLogHook(&LogCategory, NAME_None, LogVerbosity)
@@ -1,7 +1,11 @@
 // Copyright The Believer Company. All Rights Reserved.
 
+#pragma once
+
+#include "CoreMinimal.h"
+
 // NOTE: This could probably get moved into a BVPlatform plugin in the future
 namespace BVPlatformTime
 {
-	double ProcessUptimeSeconds();
+	OPENTELEMETRY_API double ProcessUptimeSeconds();
 }
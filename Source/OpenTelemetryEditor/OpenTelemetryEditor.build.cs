@@ -11,9 +11,14 @@ public class OpenTelemetryEditor : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			"Analytics",
+			"AssetRegistry",
 			"Core",
 			"CoreUObject",
+			"DerivedDataCache",
 			"Engine",
+			"Projects",
+			"Slate",
+			"SlateCore",
 			"UnrealEd",
 
 			"OpenTelemetry",
@@ -0,0 +1,196 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelAssetStats.h"
+
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/Package.h"
+
+// Editor saves happen a package at a time, so anything past this is left over from saves that failed
+static constexpr int32 MaxPendingSaves = 64;
+
+FOtelAssetStats::FOtelAssetStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	SpanThresholdMs = Module.GetConfig().Stats.EditorAssetSpanThresholdMs;
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("editor_stats"));
+
+	const double TimeBucketsRaw[] = { 10, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000, 60000 };
+	const FOtelHistogramBuckets TimeBuckets = FOtelHistogramBuckets::From(TimeBucketsRaw);
+	HistogramCompileTimeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("editor_stats_blueprint_compile_time"), TimeBuckets, EUnit::Milliseconds);
+	HistogramSaveTimeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("editor_stats_package_save_time"), TimeBuckets, EUnit::Milliseconds);
+
+	const uint64 KB = 1024;
+	const uint64 MB = KB * 1024;
+	const uint64 SaveBytesBucketsRaw[] = { KB * 16, KB * 64, KB * 256, MB, MB * 4, MB * 16, MB * 64, MB * 256, MB * 1024 };
+	const FOtelHistogramBuckets SaveBytesBuckets = FOtelHistogramBuckets::From(SaveBytesBucketsRaw);
+	HistogramSaveBytes = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("editor_stats_package_save_size"), SaveBytesBuckets, EUnit::Bytes);
+
+	UPackage::PreSavePackageWithContextEvent.AddRaw(this, &FOtelAssetStats::OnPreSavePackage);
+	UPackage::PackageSavedWithContextEvent.AddRaw(this, &FOtelAssetStats::OnPackageSaved);
+
+	// GEditor is created during engine init, after this module has loaded
+	if (GEditor)
+	{
+		OnPostEngineInit();
+	}
+	else
+	{
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FOtelAssetStats::OnPostEngineInit);
+	}
+}
+
+FOtelAssetStats::~FOtelAssetStats()
+{
+	UPackage::PreSavePackageWithContextEvent.RemoveAll(this);
+	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().RemoveAll(this);
+		GEditor->OnBlueprintCompiled().RemoveAll(this);
+	}
+}
+
+void FOtelAssetStats::OnPostEngineInit()
+{
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().AddRaw(this, &FOtelAssetStats::OnBlueprintPreCompile);
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FOtelAssetStats::OnBlueprintCompiled);
+	}
+}
+
+void FOtelAssetStats::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	const FString AssetClass = Blueprint->GetClass()->GetName();
+	const FString ParentClass = Blueprint->ParentClass ? Blueprint->ParentClass->GetName() : FString();
+
+	if (NumCompilingBlueprints == 0)
+	{
+		CompileStartTime = FOtelTimestamp::Now();
+		CompileStartSeconds = FPlatformTime::Seconds();
+		CompileBlueprintName = Blueprint->GetPathName();
+		CompileAssetClass = AssetClass;
+		CompileParentClass = ParentClass;
+	}
+	else
+	{
+		// Batches of different kinds of blueprint are labelled as such rather than by whichever came first
+		if (CompileAssetClass != AssetClass)
+		{
+			CompileAssetClass = TEXT("Mixed");
+		}
+		if (CompileParentClass != ParentClass)
+		{
+			CompileParentClass = TEXT("Mixed");
+		}
+	}
+
+	++NumCompilingBlueprints;
+}
+
+void FOtelAssetStats::OnBlueprintCompiled()
+{
+	// Also broadcast after reinstancing, without any blueprints having been compiled
+	if (NumCompilingBlueprints == 0)
+	{
+		return;
+	}
+
+	const double DurationMs = (FPlatformTime::Seconds() - CompileStartSeconds) * 1000.0;
+
+	FAnalyticsEventAttribute MetricAttributes[] = { FAnalyticsEventAttribute(TEXT("asset_class"), CompileAssetClass) };
+	HistogramCompileTimeMs->Record(DurationMs, MetricAttributes);
+
+	if (DurationMs >= SpanThresholdMs)
+	{
+		TArray<FAnalyticsEventAttribute> Attributes;
+		Attributes.Emplace(TEXT("AssetClass"), CompileAssetClass);
+		Attributes.Emplace(TEXT("ParentClass"), CompileParentClass);
+		Attributes.Emplace(TEXT("Blueprints"), NumCompilingBlueprints);
+		if (NumCompilingBlueprints == 1)
+		{
+			Attributes.Emplace(TEXT("Blueprint"), CompileBlueprintName);
+		}
+
+		FOtelSpan CompileSpan = Module.GetTracer().StartSpanOpts(TEXT("CompileBlueprint"), TEXT(__FILE__), __LINE__, nullptr, Attributes, &CompileStartTime);
+	}
+
+	NumCompilingBlueprints = 0;
+}
+
+void FOtelAssetStats::OnPreSavePackage(UPackage* Package, FObjectPreSaveContext Context)
+{
+	// Cooked saves are covered by FOtelCookStats
+	if (Package == nullptr || Context.IsCooking())
+	{
+		return;
+	}
+
+	const UObject* Asset = Package->FindAssetInPackage();
+
+	// Saves that fail before the post-save notification never remove themselves. The oldest is the least likely to
+	// still finish.
+	if (PendingSaves.Num() >= MaxPendingSaves && PendingSaves.Contains(Package) == false)
+	{
+		const UPackage* OldestPackage = nullptr;
+		double OldestSeconds = MAX_dbl;
+		for (const TPair<const UPackage*, FPendingSave>& Pair : PendingSaves)
+		{
+			if (Pair.Value.StartSeconds < OldestSeconds)
+			{
+				OldestPackage = Pair.Key;
+				OldestSeconds = Pair.Value.StartSeconds;
+			}
+		}
+		PendingSaves.Remove(OldestPackage);
+	}
+
+	FPendingSave& Pending = PendingSaves.Add(Package);
+	Pending.StartTime = FOtelTimestamp::Now();
+	Pending.StartSeconds = FPlatformTime::Seconds();
+	Pending.AssetClass = Asset ? Asset->GetClass()->GetName() : TEXT("None");
+}
+
+void FOtelAssetStats::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext Context)
+{
+	FPendingSave Pending;
+	if (Context.IsCooking() || PendingSaves.RemoveAndCopyValue(Package, Pending) == false)
+	{
+		return;
+	}
+
+	// A failed save has nothing on disk to measure
+	if (Context.SaveSucceeded() == false)
+	{
+		return;
+	}
+
+	const double DurationMs = (FPlatformTime::Seconds() - Pending.StartSeconds) * 1000.0;
+	const int64 SizeBytes = FMath::Max<int64>(IFileManager::Get().FileSize(*PackageFileName), 0);
+
+	FAnalyticsEventAttribute MetricAttributes[] = { FAnalyticsEventAttribute(TEXT("asset_class"), Pending.AssetClass) };
+	HistogramSaveTimeMs->Record(DurationMs, MetricAttributes);
+	HistogramSaveBytes->Record(static_cast<uint64>(SizeBytes), MetricAttributes);
+
+	if (DurationMs >= SpanThresholdMs)
+	{
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("Package"), Package->GetName()),
+			FAnalyticsEventAttribute(TEXT("AssetClass"), Pending.AssetClass),
+			FAnalyticsEventAttribute(TEXT("SizeBytes"), SizeBytes)
+		};
+
+		FOtelSpan SaveSpan = Module.GetTracer().StartSpanOpts(TEXT("SavePackage"), TEXT(__FILE__), __LINE__, nullptr, Attributes, &Pending.StartTime);
+	}
+}
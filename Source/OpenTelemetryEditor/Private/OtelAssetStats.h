@@ -0,0 +1,49 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+#include "UObject/ObjectSaveContext.h"
+
+class UBlueprint;
+
+// Times blueprint compiles and package saves in the editor, see FOtelStatsConfig::EditorAssetSpanThresholdMs. The
+// blueprint compilation manager compiles queued blueprints in batches and only reports when the whole batch is done, so
+// a compile is timed from the first blueprint in the batch starting until the batch finishes.
+class FOtelAssetStats
+{
+public:
+	FOtelAssetStats(FOtelModule& InModule);
+	~FOtelAssetStats();
+
+private:
+	struct FPendingSave
+	{
+		FOtelTimestamp StartTime;
+		double StartSeconds = 0.0;
+		FString AssetClass;
+	};
+
+	void OnPostEngineInit();
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	void OnBlueprintCompiled();
+	void OnPreSavePackage(UPackage* Package, FObjectPreSaveContext Context);
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext Context);
+
+	FOtelModule& Module;
+	double SpanThresholdMs = 0.0;
+
+	int32 NumCompilingBlueprints = 0;
+	FOtelTimestamp CompileStartTime;
+	double CompileStartSeconds = 0.0;
+	FString CompileBlueprintName;
+	FString CompileAssetClass;
+	FString CompileParentClass;
+
+	TMap<const UPackage*, FPendingSave> PendingSaves;
+
+	TSharedPtr<FOtelHistogram> HistogramCompileTimeMs;
+	TSharedPtr<FOtelHistogram> HistogramSaveTimeMs;
+	TSharedPtr<FOtelHistogram> HistogramSaveBytes;
+};
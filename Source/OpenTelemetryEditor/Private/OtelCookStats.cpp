@@ -0,0 +1,158 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelCookStats.h"
+#include "OtelPlatformTime.h"
+
+#include "Misc/CoreDelegates.h"
+#include "UObject/ICookInfo.h"
+#include "UObject/Package.h"
+
+FOtelCookStats::FOtelCookStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	const FOtelStatsConfig& Config = Module.GetConfig().Stats;
+	SpanThresholdMs = Config.CookPackageSpanThresholdMs;
+	MaxPackageSpans = Config.CookMaxPackageSpans;
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("cook_stats"));
+
+	const double PackageTimeBucketsRaw[] = { 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+	const FOtelHistogramBuckets PackageTimeBuckets = FOtelHistogramBuckets::From(PackageTimeBucketsRaw);
+	HistogramPackageTimeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("cook_stats_package_time"), PackageTimeBuckets, EUnit::Milliseconds);
+
+	// The commandlet has been running since the process started, long before this module was loaded
+	FOtelTimestamp StartTime = FOtelTimestamp::Now();
+	const double UptimeSeconds = BVPlatformTime::ProcessUptimeSeconds();
+	if (UptimeSeconds > 0.0)
+	{
+		const int64 UptimeNanoseconds = static_cast<int64>(UptimeSeconds * 1e9);
+		StartTime.System -= UptimeNanoseconds;
+		StartTime.Steady -= UptimeNanoseconds;
+	}
+
+	FOtelTracer Tracer = Module.GetTracer();
+	const FOtelSpan CommandletSpan = Module.GetCommandletSpan();
+	CookSpan = Tracer.StartSpanOpts(TEXT("Cook"), TEXT(__FILE__), __LINE__, &CommandletSpan, {}, &StartTime);
+	PhaseSpan = Tracer.StartSpanOpts(TEXT("CookStartup"), TEXT(__FILE__), __LINE__, &CookSpan, {}, &StartTime);
+
+	UE::Cook::FDelegates::CookByTheBookStarted.AddRaw(this, &FOtelCookStats::OnCookStarted);
+	UE::Cook::FDelegates::CookByTheBookFinished.AddRaw(this, &FOtelCookStats::OnCookFinished);
+	UPackage::PreSavePackageWithContextEvent.AddRaw(this, &FOtelCookStats::OnPreSavePackage);
+	UPackage::PackageSavedWithContextEvent.AddRaw(this, &FOtelCookStats::OnPackageSaved);
+	FCoreDelegates::OnEnginePreExit.AddRaw(this, &FOtelCookStats::OnEnginePreExit);
+}
+
+FOtelCookStats::~FOtelCookStats()
+{
+	UE::Cook::FDelegates::CookByTheBookStarted.RemoveAll(this);
+	UE::Cook::FDelegates::CookByTheBookFinished.RemoveAll(this);
+	UPackage::PreSavePackageWithContextEvent.RemoveAll(this);
+	UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+	FCoreDelegates::OnEnginePreExit.RemoveAll(this);
+
+	Finish();
+}
+
+void FOtelCookStats::BeginPhase(const TCHAR* PhaseName)
+{
+	FOtelTimestamp Now = FOtelTimestamp::Now();
+	PhaseSpan.End(&Now);
+	PhaseSpan = Module.GetTracer().StartSpanOpts(PhaseName, TEXT(__FILE__), __LINE__, &CookSpan, {}, &Now);
+}
+
+void FOtelCookStats::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+	bFinished = true;
+
+	const FAnalyticsEventAttribute Attributes[] = {
+		FAnalyticsEventAttribute(TEXT("Packages"), NumPackages),
+		FAnalyticsEventAttribute(TEXT("PackageSpans"), NumPackageSpans),
+		FAnalyticsEventAttribute(TEXT("DroppedPackageSpans"), NumDroppedPackageSpans)
+	};
+	CookSpan.AddAttributes(Attributes);
+
+	PhaseSpan.End();
+	CookSpan.End();
+	PhaseSpan = FOtelSpan();
+	CookSpan = FOtelSpan();
+	PendingPackages.Empty();
+}
+
+void FOtelCookStats::OnCookStarted(UE::Cook::ICookInfo& CookInfo)
+{
+	bCookStarted = true;
+	BeginPhase(TEXT("CookPackages"));
+}
+
+void FOtelCookStats::OnCookFinished(UE::Cook::ICookInfo& CookInfo)
+{
+	BeginPhase(TEXT("CookShutdown"));
+}
+
+void FOtelCookStats::OnPreSavePackage(UPackage* Package, FObjectPreSaveContext Context)
+{
+	if (bFinished || Package == nullptr || Context.IsCooking() == false)
+	{
+		return;
+	}
+
+	// Cooks that aren't driven by cook-by-the-book don't announce when they start, so the first package does
+	if (bCookStarted == false)
+	{
+		bCookStarted = true;
+		BeginPhase(TEXT("CookPackages"));
+	}
+
+	const UObject* Asset = Package->FindAssetInPackage();
+
+	FPendingPackage& Pending = PendingPackages.Add(Package);
+	Pending.StartTime = FOtelTimestamp::Now();
+	Pending.StartSeconds = FPlatformTime::Seconds();
+	Pending.AssetClass = Asset ? Asset->GetClass()->GetName() : TEXT("None");
+}
+
+void FOtelCookStats::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext Context)
+{
+	FPendingPackage Pending;
+	if (Context.IsCooking() == false || PendingPackages.RemoveAndCopyValue(Package, Pending) == false)
+	{
+		return;
+	}
+
+	++NumPackages;
+
+	const double DurationMs = (FPlatformTime::Seconds() - Pending.StartSeconds) * 1000.0;
+
+	FAnalyticsEventAttribute MetricAttributes[] = { FAnalyticsEventAttribute(TEXT("asset_class"), Pending.AssetClass) };
+	HistogramPackageTimeMs->Record(DurationMs, MetricAttributes);
+
+	if (SpanThresholdMs <= 0.0 || DurationMs < SpanThresholdMs)
+	{
+		return;
+	}
+
+	// The histogram already has every package, so past the cap slow packages are only counted, which keeps a large
+	// cook from flooding the span exporter
+	if (NumPackageSpans >= MaxPackageSpans)
+	{
+		++NumDroppedPackageSpans;
+		return;
+	}
+	++NumPackageSpans;
+
+	const FAnalyticsEventAttribute Attributes[] = {
+		FAnalyticsEventAttribute(TEXT("Package"), Package->GetName()),
+		FAnalyticsEventAttribute(TEXT("AssetClass"), Pending.AssetClass)
+	};
+
+	FOtelSpan PackageSpan = Module.GetTracer().StartSpanOpts(TEXT("CookPackage"), TEXT(__FILE__), __LINE__, &PhaseSpan, Attributes, &Pending.StartTime);
+}
+
+void FOtelCookStats::OnEnginePreExit()
+{
+	Finish();
+}
@@ -0,0 +1,52 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+#include "UObject/ObjectSaveContext.h"
+
+namespace UE::Cook { class ICookInfo; }
+
+// Traces a cook commandlet: a Cook root span from process start to engine exit, with CookStartup, CookPackages and
+// CookShutdown phase spans under it. Packages that take at least CookPackageSpanThresholdMs to save get a CookPackage
+// span, up to CookMaxPackageSpans per cook, and every package is counted in cook_stats_package_time by asset class.
+class FOtelCookStats
+{
+public:
+	FOtelCookStats(FOtelModule& InModule);
+	~FOtelCookStats();
+
+private:
+	struct FPendingPackage
+	{
+		FOtelTimestamp StartTime;
+		double StartSeconds = 0.0;
+		FString AssetClass;
+	};
+
+	void BeginPhase(const TCHAR* PhaseName);
+	void Finish();
+
+	void OnCookStarted(UE::Cook::ICookInfo& CookInfo);
+	void OnCookFinished(UE::Cook::ICookInfo& CookInfo);
+	void OnPreSavePackage(UPackage* Package, FObjectPreSaveContext Context);
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext Context);
+	void OnEnginePreExit();
+
+	FOtelModule& Module;
+	double SpanThresholdMs = 0.0;
+	int32 MaxPackageSpans = 0;
+
+	FOtelSpan CookSpan;
+	FOtelSpan PhaseSpan;
+	bool bCookStarted = false;
+	bool bFinished = false;
+
+	TMap<const UPackage*, FPendingPackage> PendingPackages;
+	int32 NumPackages = 0;
+	int32 NumPackageSpans = 0;
+	int32 NumDroppedPackageSpans = 0;
+
+	TSharedPtr<FOtelHistogram> HistogramPackageTimeMs;
+};
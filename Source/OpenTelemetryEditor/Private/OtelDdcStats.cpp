@@ -0,0 +1,139 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelDdcStats.h"
+
+#include "DerivedDataCacheInterface.h"
+#include "DerivedDataCacheUsageStats.h"
+
+#if ENABLE_COOK_STATS
+static void GatherLeafNodes(const TSharedRef<FDerivedDataCacheStatsNode>& Node, TArray<TSharedRef<FDerivedDataCacheStatsNode>>& OutLeaves)
+{
+	// Hierarchical and async nodes forward to their children, so only the leaves are actual cache stores
+	if (Node->Children.IsEmpty())
+	{
+		OutLeaves.Add(Node);
+		return;
+	}
+
+	for (const TSharedRef<FDerivedDataCacheStatsNode>& Child : Node->Children)
+	{
+		GatherLeafNodes(Child, OutLeaves);
+	}
+}
+#endif
+
+FOtelDdcStats::FOtelDdcStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	FOtelMeter Meter = Module.GetMeter(TEXT("editor_stats"));
+
+	CounterRequests = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("editor_stats_ddc_requests"));
+	CounterBytes = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("editor_stats_ddc_bytes"), EUnit::Bytes);
+	CounterLatencyTimeMs = Meter.CreateCounter(EOtelInstrumentType::Double, TEXT("editor_stats_ddc_latency_time"), EUnit::Milliseconds);
+
+	Module.RegisterCollector(this);
+}
+
+FOtelDdcStats::~FOtelDdcStats()
+{
+	Module.UnregisterCollector(this);
+}
+
+FName FOtelDdcStats::GetName() const
+{
+	return TEXT("DdcStats");
+}
+
+FOtelCollectorSettings FOtelDdcStats::GetDefaultSettings() const
+{
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 5.0;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
+
+void FOtelDdcStats::Collect(double DeltaSeconds)
+{
+#if ENABLE_COOK_STATS
+	FDerivedDataCacheInterface* DDC = GetDerivedDataCache();
+	if (DDC == nullptr)
+	{
+		return;
+	}
+
+	TArray<TSharedRef<FDerivedDataCacheStatsNode>> Leaves;
+	GatherLeafNodes(DDC->GatherUsageStats(), Leaves);
+
+	using EHitOrMiss = FCookStats::CallStats::EHitOrMiss;
+	using EStatType = FCookStats::CallStats::EStatType;
+
+	TMap<FString, FSeries> Series;
+	auto Accumulate = [&Series](const FDerivedDataCacheStatsNode& Node, const TCHAR* Op, const FCookStats::CallStats& Stats)
+		{
+			const FString Key = FString::Printf(TEXT("%s|%d|%s"), *Node.GetCacheType(), Node.IsLocal() ? 1 : 0, Op);
+			FSeries& Entry = Series.FindOrAdd(Key);
+			Entry.CacheType = Node.GetCacheType();
+			Entry.bIsLocal = Node.IsLocal();
+			Entry.Op = Op;
+
+			const EHitOrMiss Results[] = { EHitOrMiss::Hit, EHitOrMiss::Miss };
+			for (int32 Index = 0; Index < UE_ARRAY_COUNT(Results); ++Index)
+			{
+				Entry.Count[Index] += Stats.GetAccumulatedValueAnyThread(Results[Index], EStatType::Counter);
+				Entry.Cycles[Index] += Stats.GetAccumulatedValueAnyThread(Results[Index], EStatType::Cycles);
+				Entry.Bytes[Index] += Stats.GetAccumulatedValueAnyThread(Results[Index], EStatType::Bytes);
+			}
+		};
+
+	for (const TSharedRef<FDerivedDataCacheStatsNode>& Leaf : Leaves)
+	{
+		for (const TPair<FString, FDerivedDataCacheUsageStats>& Usage : Leaf->UsageStats)
+		{
+			Accumulate(*Leaf, TEXT("get"), Usage.Value.GetStats);
+			Accumulate(*Leaf, TEXT("put"), Usage.Value.PutStats);
+		}
+	}
+
+	const TCHAR* ResultNames[] = { TEXT("hit"), TEXT("miss") };
+	for (const TPair<FString, FSeries>& Pair : Series)
+	{
+		const FSeries& Current = Pair.Value;
+		const FSeries* Last = LastSeries.Find(Pair.Key);
+
+		FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("cache_type"), Current.CacheType),
+			FAnalyticsEventAttribute(TEXT("tier"), Current.bIsLocal ? TEXT("local") : TEXT("remote")),
+			FAnalyticsEventAttribute(TEXT("op"), Current.Op),
+			FAnalyticsEventAttribute(TEXT("result"), TEXT("")),
+		};
+
+		int64 DeltaBytes = 0;
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(ResultNames); ++Index)
+		{
+			// Totals only go down if a cache store was removed, which restarts its series
+			const int64 DeltaCount = FMath::Max<int64>(Current.Count[Index] - (Last ? Last->Count[Index] : 0), 0);
+			const int64 DeltaCycles = FMath::Max<int64>(Current.Cycles[Index] - (Last ? Last->Cycles[Index] : 0), 0);
+			DeltaBytes += FMath::Max<int64>(Current.Bytes[Index] - (Last ? Last->Bytes[Index] : 0), 0);
+
+			if (DeltaCount == 0)
+			{
+				continue;
+			}
+
+			Attributes[3] = FAnalyticsEventAttribute(TEXT("result"), ResultNames[Index]);
+			CounterRequests->Add(static_cast<uint64>(DeltaCount), Attributes);
+
+			// Per-request timings aren't kept, so the time is published as a total next to the request count. Dividing
+			// the two rates gives the mean latency over any window.
+			CounterLatencyTimeMs->Add(FPlatformTime::ToMilliseconds64(DeltaCycles), Attributes);
+		}
+
+		if (DeltaBytes > 0)
+		{
+			CounterBytes->Add(static_cast<uint64>(DeltaBytes), TArrayView<FAnalyticsEventAttribute>(Attributes, 3));
+		}
+	}
+
+	LastSeries = MoveTemp(Series);
+#endif
+}
@@ -0,0 +1,41 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+// Reports Derived Data Cache requests by cache type, tier (local or remote), operation and hit or miss, along with the
+// bytes transferred and the total time spent on requests. The DDC only keeps running totals, so each collection
+// publishes the change since the previous one.
+class FOtelDdcStats : public IOtelCollector
+{
+public:
+	FOtelDdcStats(FOtelModule& InModule);
+	~FOtelDdcStats();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	// Running totals for one cache type, tier and operation, summed over every cache store that matches, indexed by
+	// hit (0) and miss (1)
+	struct FSeries
+	{
+		FString CacheType;
+		bool bIsLocal = false;
+		const TCHAR* Op = nullptr;
+		int64 Count[2] = {};
+		int64 Cycles[2] = {};
+		int64 Bytes[2] = {};
+	};
+
+	FOtelModule& Module;
+
+	TMap<FString, FSeries> LastSeries;
+
+	TSharedPtr<FOtelCounter> CounterRequests;
+	TSharedPtr<FOtelCounter> CounterBytes;
+	TSharedPtr<FOtelCounter> CounterLatencyTimeMs;
+};
@@ -0,0 +1,275 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelEditorFrameStats.h"
+
+#include "Editor.h"
+#include "EditorModeManager.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FeedbackContext.h"
+#include "Misc/SlowTask.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/Docking/SDockTab.h"
+
+// The editor in use rarely changes from one frame to the next, and finding it walks every open asset editor
+static const double ContextRefreshSeconds = 1.0;
+
+// Bounds the span tree sent for one outermost slow task, e.g. one per asset in a bulk operation
+static const int32 MaxSlowTaskRecords = 256;
+
+FOtelEditorFrameStats::FOtelEditorFrameStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	const FOtelStatsConfig& Config = Module.GetConfig().Stats;
+	HitchThresholdMs = Config.EditorHitchThresholdMs;
+	SlowTaskSpanThresholdMs = Config.SlowTaskSpanThresholdMs;
+
+	FOtelMeter Meter = Module.GetMeter(TEXT("editor_stats"));
+
+	const double FrameTimeBucketsRaw[] = { 8, 16, 33, 50, 100, 250, 500, 1000, 2500 };
+	const FOtelHistogramBuckets FrameTimeBuckets = FOtelHistogramBuckets::From(FrameTimeBucketsRaw);
+	HistogramFrameTimeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("editor_stats_frame_time"), FrameTimeBuckets, EUnit::Milliseconds);
+
+	const double SlowTaskBucketsRaw[] = { 100, 500, 1000, 2500, 5000, 10000, 30000, 60000, 300000 };
+	const FOtelHistogramBuckets SlowTaskBuckets = FOtelHistogramBuckets::From(SlowTaskBucketsRaw);
+	HistogramSlowTaskTimeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("editor_stats_slow_task_time"), SlowTaskBuckets, EUnit::Milliseconds);
+
+	CounterHitches = Meter.CreateCounter(EOtelInstrumentType::Int64, TEXT("editor_stats_hitches"));
+
+	if (GEditor && FSlateApplication::IsInitialized())
+	{
+		OnPostEngineInit();
+	}
+	else
+	{
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FOtelEditorFrameStats::OnPostEngineInit);
+	}
+}
+
+FOtelEditorFrameStats::~FOtelEditorFrameStats()
+{
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+
+	if (bBound && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnPreTick().RemoveAll(this);
+	}
+}
+
+void FOtelEditorFrameStats::OnPostEngineInit()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnPreTick().AddRaw(this, &FOtelEditorFrameStats::OnPreTick);
+		bBound = true;
+		LastTickSeconds = FPlatformTime::Seconds();
+	}
+}
+
+void FOtelEditorFrameStats::OnPreTick(float DeltaTime)
+{
+	const double NowSeconds = FPlatformTime::Seconds();
+	const double FrameMs = (NowSeconds - LastTickSeconds) * 1000.0;
+	LastTickSeconds = NowSeconds;
+
+	UpdateSlowTasks();
+
+	// A frame is left out if a slow task was running at either end of it. So is one where the editor was in the
+	// background or throttled at either end, since its frame time is then mostly the editor sleeping on purpose.
+	const bool bInSlowTask = ActiveSlowTasks.Num() > 0;
+	const bool bThrottled = FSlateApplication::Get().IsActive() == false || (GEditor && GEditor->ShouldThrottleCPUUsage());
+	const bool bSkipFrame = bInSlowTask || bFrameHadSlowTask || bThrottled || bFrameWasThrottled;
+	bFrameHadSlowTask = bInSlowTask;
+	bFrameWasThrottled = bThrottled;
+	if (bSkipFrame)
+	{
+		return;
+	}
+
+	if (Context.IsEmpty() || NowSeconds - LastContextSeconds >= ContextRefreshSeconds)
+	{
+		Context = FindContext();
+		LastContextSeconds = NowSeconds;
+	}
+
+	FAnalyticsEventAttribute MetricAttributes[] = { FAnalyticsEventAttribute(TEXT("context"), Context) };
+	HistogramFrameTimeMs->Record(FrameMs, MetricAttributes);
+
+	if (HitchThresholdMs > 0.0 && FrameMs >= HitchThresholdMs)
+	{
+		CounterHitches->Add(1ull, MetricAttributes);
+
+		const int64 FrameNanoseconds = static_cast<int64>(FrameMs * 1e6);
+		FOtelTimestamp StartTime = FOtelTimestamp::Now();
+		StartTime.System -= FrameNanoseconds;
+		StartTime.Steady -= FrameNanoseconds;
+
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("Context"), Context),
+			FAnalyticsEventAttribute(TEXT("FrameMs"), FrameMs)
+		};
+
+		FOtelSpan HitchSpan = Module.GetTracer().StartSpanOpts(TEXT("EditorHitch"), TEXT(__FILE__), __LINE__, nullptr, Attributes, &StartTime);
+	}
+}
+
+void FOtelEditorFrameStats::UpdateSlowTasks()
+{
+	if (GWarn == nullptr)
+	{
+		return;
+	}
+
+	const FSlowTaskStack& Stack = GWarn->GetScopeStack();
+	const FOtelTimestamp Now = FOtelTimestamp::Now();
+	const double NowSeconds = FPlatformTime::Seconds();
+
+	// Scopes live on the stack, so a new task can reuse a finished one's address. Tasks are matched on their message too,
+	// and everything above the first mismatch has finished.
+	int32 NumMatching = 0;
+	while (NumMatching < ActiveSlowTasks.Num() && NumMatching < Stack.Num())
+	{
+		const FActiveSlowTask& Active = ActiveSlowTasks[NumMatching];
+		const FSlowTask* Task = Stack[NumMatching];
+		if (Active.Task != Task || Active.Message != Task->DefaultMessage.ToString())
+		{
+			break;
+		}
+		++NumMatching;
+	}
+
+	for (int32 Index = ActiveSlowTasks.Num() - 1; Index >= NumMatching; --Index)
+	{
+		const FActiveSlowTask& Active = ActiveSlowTasks[Index];
+		if (Active.bRecorded)
+		{
+			FSlowTaskRecord& Record = SlowTaskRecords[Active.RecordIndex];
+			Record.EndTime = Now;
+			Record.EndSeconds = NowSeconds;
+		}
+	}
+	ActiveSlowTasks.SetNum(NumMatching);
+
+	if (ActiveSlowTasks.IsEmpty() && SlowTaskRecords.Num() > 0)
+	{
+		SendSlowTasks();
+		SlowTaskRecords.Reset();
+	}
+
+	for (int32 Index = NumMatching; Index < Stack.Num(); ++Index)
+	{
+		const FSlowTask* Task = Stack[Index];
+		const int32 ParentIndex = (Index > 0) ? ActiveSlowTasks[Index - 1].RecordIndex : INDEX_NONE;
+
+		FActiveSlowTask& Active = ActiveSlowTasks.AddDefaulted_GetRef();
+		Active.Task = Task;
+		Active.Message = Task->DefaultMessage.ToString();
+
+		// Past the limit, nested tasks are folded into their parent
+		if (SlowTaskRecords.Num() >= MaxSlowTaskRecords)
+		{
+			Active.RecordIndex = ParentIndex;
+			continue;
+		}
+
+		Active.RecordIndex = SlowTaskRecords.Num();
+		Active.bRecorded = true;
+
+		FSlowTaskRecord& Record = SlowTaskRecords.AddDefaulted_GetRef();
+		Record.Message = Active.Message;
+		Record.StartTime = Now;
+		Record.StartSeconds = NowSeconds;
+		Record.ParentIndex = ParentIndex;
+		Record.Depth = Index;
+	}
+}
+
+void FOtelEditorFrameStats::SendSlowTasks()
+{
+	const FSlowTaskRecord& Root = SlowTaskRecords[0];
+	const double RootMs = (Root.EndSeconds - Root.StartSeconds) * 1000.0;
+	HistogramSlowTaskTimeMs->Record(RootMs, {});
+
+	if (SlowTaskSpanThresholdMs <= 0.0 || RootMs < SlowTaskSpanThresholdMs)
+	{
+		return;
+	}
+
+	// Tasks under the threshold are skipped, and their children are attached to the closest ancestor that was sent
+	FOtelTracer Tracer = Module.GetTracer();
+	TArray<FOtelSpan> Spans;
+	TArray<bool> Sent;
+	Spans.SetNum(SlowTaskRecords.Num());
+	Sent.SetNumZeroed(SlowTaskRecords.Num());
+
+	for (int32 Index = 0; Index < SlowTaskRecords.Num(); ++Index)
+	{
+		FSlowTaskRecord& Record = SlowTaskRecords[Index];
+		const FOtelSpan* Parent = (Record.ParentIndex != INDEX_NONE) ? &Spans[Record.ParentIndex] : nullptr;
+
+		const double DurationMs = (Record.EndSeconds - Record.StartSeconds) * 1000.0;
+		if (Index > 0 && DurationMs < SlowTaskSpanThresholdMs)
+		{
+			Spans[Index] = *Parent;
+			continue;
+		}
+
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("Message"), Record.Message),
+			FAnalyticsEventAttribute(TEXT("Depth"), Record.Depth)
+		};
+
+		Spans[Index] = Tracer.StartSpanOpts(TEXT("SlowTask"), TEXT(__FILE__), __LINE__, Parent, Attributes, &Record.StartTime);
+		Sent[Index] = true;
+	}
+
+	for (int32 Index = 0; Index < SlowTaskRecords.Num(); ++Index)
+	{
+		if (Sent[Index])
+		{
+			Spans[Index].End(&SlowTaskRecords[Index].EndTime);
+		}
+	}
+}
+
+FString FOtelEditorFrameStats::FindContext() const
+{
+	UAssetEditorSubsystem* AssetEditors = GEditor ? GEditor->GetEditorSubsystem<UAssetEditorSubsystem>() : nullptr;
+	if (AssetEditors == nullptr)
+	{
+		return TEXT("None");
+	}
+
+	// Asset editors track when they were last brought to the front. The most recent one is the one in use if its tab is
+	// still in front, in the active window.
+	IAssetEditorInstance* MostRecentEditor = nullptr;
+	for (UObject* Asset : AssetEditors->GetAllEditedAssets())
+	{
+		IAssetEditorInstance* Editor = AssetEditors->FindEditorForAsset(Asset, false);
+		if (Editor && (MostRecentEditor == nullptr || Editor->GetLastActivationTime() > MostRecentEditor->GetLastActivationTime()))
+		{
+			MostRecentEditor = Editor;
+		}
+	}
+
+	if (MostRecentEditor)
+	{
+		TSharedPtr<FTabManager> TabManager = MostRecentEditor->GetAssociatedTabManager();
+		TSharedPtr<SDockTab> OwnerTab = TabManager ? TabManager->GetOwnerTab() : nullptr;
+		if (OwnerTab && OwnerTab->IsForeground() && OwnerTab->GetParentWindow() == FSlateApplication::Get().GetActiveTopLevelWindow())
+		{
+			return MostRecentEditor->GetEditorName().ToString();
+		}
+	}
+
+	// Otherwise it's the level editor, labelled with its highest priority active mode
+	for (const FEditorModeInfo& ModeInfo : AssetEditors->GetEditorModeInfoOrderedByPriority())
+	{
+		if (GLevelEditorModeTools().IsModeActive(ModeInfo.ID))
+		{
+			return FString::Printf(TEXT("LevelEditor.%s"), *ModeInfo.ID.ToString());
+		}
+	}
+	return TEXT("LevelEditor");
+}
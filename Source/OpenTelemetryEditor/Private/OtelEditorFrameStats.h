@@ -0,0 +1,67 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+struct FSlowTask;
+
+// Watches the editor from the Slate tick, which also runs while a modal slow task updates its dialog:
+// * Frame times go into editor_stats_frame_time, labelled with the asset editor or level editor mode in use. Frames
+//   that hitch past EditorHitchThresholdMs get an EditorHitch span too. Frames while the editor is in the background
+//   or throttling its CPU usage are left out of both.
+// * FScopedSlowTask scopes are followed through the feedback context's scope stack. Once the outermost one finishes,
+//   it and the tasks nested under it that took at least SlowTaskSpanThresholdMs are sent as a tree of SlowTask spans.
+//   Frames spent in slow tasks are left out of the frame times, since the task is what's being waited on.
+class FOtelEditorFrameStats
+{
+public:
+	FOtelEditorFrameStats(FOtelModule& InModule);
+	~FOtelEditorFrameStats();
+
+private:
+	struct FSlowTaskRecord
+	{
+		FString Message;
+		FOtelTimestamp StartTime;
+		FOtelTimestamp EndTime;
+		double StartSeconds = 0.0;
+		double EndSeconds = 0.0;
+		int32 ParentIndex = INDEX_NONE;
+		int32 Depth = 0;
+	};
+
+	struct FActiveSlowTask
+	{
+		const FSlowTask* Task = nullptr;
+		FString Message;
+		int32 RecordIndex = INDEX_NONE;
+		bool bRecorded = false;
+	};
+
+	void OnPostEngineInit();
+	void OnPreTick(float DeltaTime);
+
+	void UpdateSlowTasks();
+	void SendSlowTasks();
+	FString FindContext() const;
+
+	FOtelModule& Module;
+	double HitchThresholdMs = 0.0;
+	double SlowTaskSpanThresholdMs = 0.0;
+	bool bBound = false;
+
+	double LastTickSeconds = 0.0;
+	double LastContextSeconds = 0.0;
+	FString Context;
+
+	// The outermost slow task and everything nested in it, in the order they started, so parents come before children
+	TArray<FSlowTaskRecord> SlowTaskRecords;
+	TArray<FActiveSlowTask> ActiveSlowTasks;
+	bool bFrameHadSlowTask = false;
+	bool bFrameWasThrottled = false;
+
+	TSharedPtr<FOtelHistogram> HistogramFrameTimeMs;
+	TSharedPtr<FOtelHistogram> HistogramSlowTaskTimeMs;
+	TSharedPtr<FOtelCounter> CounterHitches;
+};
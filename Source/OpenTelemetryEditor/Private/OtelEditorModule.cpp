@@ -1,15 +1,32 @@
 // Copyright The Believer Company. All Rights Reserved.
 
 #include "Modules/ModuleManager.h"
+#include "OtelAssetStats.h"
+#include "OtelCookStats.h"
+#include "OtelDdcStats.h"
+#include "OtelEditorFrameStats.h"
+#include "OtelPieListener.h"
 #include "OtelPlatformTime.h"
+#include "OtelShaderStats.h"
 
 #include "Otel.h"
 
 #include "AnalyticsEventAttribute.h"
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "Editor.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreaming.h"
+#include "GameFramework/PlayerController.h"
+#include "Interfaces/IPluginManager.h"
 #include "LevelInstance/LevelInstanceActor.h"
 #include "LevelInstance/LevelInstanceSubsystem.h"
-#include "EngineUtils.h"
+#include "LevelUtils.h"
+#include "UObject/StrongObjectPtr.h"
+#include "WorldPartition/WorldPartitionLevelStreamingDynamic.h"
+
+// A map load that goes this long without a level finishing is ended, in case something it was waiting on was dropped
+// without any event saying so
+static const float MapLoadTimeoutSeconds = 30.0f;
 
 static FString ParseMapName(UWorld* World)
 {
@@ -29,16 +46,39 @@ static FString ParseMapName(UWorld* World)
 struct FOtelEditorAnalytics
 {
 	TOptional<uint64> LaunchPieSpanId;
-	FTimerHandle LaunchPieTimer;
+	FOtelSpan LaunchPieSpan;
+	FOtelTimestamp LaunchPieStartTime;
+	FString LaunchPieMapName;
+	bool bLaunchPieHasServer = false;
+	TMap<TWeakObjectPtr<UWorld>, FOtelSpan> PendingPieClients;
+	TArray<TWeakObjectPtr<UGameInstance>> PieGameInstances;
+	TStrongObjectPtr<UOtelPieListener> PieListener;
 
 	TOptional<uint64> MapLoadSpanId;
+	FOtelSpan MapLoadSpan;
 	FString MapLoadName;
-	FTimerHandle MapLoadTimer;
 	FOtelTimestamp MapLoadStartTime;
+	FOtelTimestamp LastMapLoadEventTime;
+	TWeakObjectPtr<UWorld> MapLoadWorld;
+	TArray<TWeakObjectPtr<ALevelInstance>> PendingLevelInstances;
+	TMap<const ULevelStreaming*, FOtelTimestamp> PendingStreamingLevels;
+	bool bMapLoadScanned = false;
+	bool bMapLoadCheckQueued = false;
+	FTimerHandle MapLoadTimeoutHandle;
 
 	TSharedPtr<FOtelCounter> NumPieLaunches;
 
 	bool bShouldSendInitialEditorStartSpan = true;
+	FOtelTimestamp ModuleStartupTime;
+	FOtelTimestamp ProcessStartTime;
+	FOtelSpan LaunchSpan;
+	bool bLaunchSpanStarted = false;
+	TArray<TPair<ELoadingPhase::Type, FOtelTimestamp>> LoadingPhaseTimes;
+	TOptional<FOtelTimestamp> EngineInitTime;
+	TOptional<FOtelTimestamp> AssetScanTime;
+	TOptional<FOtelTimestamp> FirstMapLoadStartTime;
+	TOptional<FOtelTimestamp> FirstMapLoadEndTime;
+	FString FirstMapName;
 
 	FOtelEditorAnalytics()
 	{
@@ -49,66 +89,83 @@ struct FOtelEditorAnalytics
 
 	// PIE start time hooks
 
-	void LaunchPieEndedTick()
+	// Clients count as ready once their local player controller possesses a pawn, which is when it enters the
+	// Playing state
+	void OnPiePawnControllerChanged(APawn* Pawn, AController* Controller)
 	{
-		TArray<UWorld*, TInlineAllocator<4>> ClientWorlds;
-		bool bDidFindServerWorld = false;
+		APlayerController* PC = Cast<APlayerController>(Controller);
+		if (Pawn && PC && PC->IsLocalController())
 		{
-			const TIndirectArray<FWorldContext>& WorldContexts = GEngine->GetWorldContexts();
-			for (const FWorldContext& Context : WorldContexts)
+			OnPieClientReady(PC->GetWorld());
+		}
+	}
+
+	void OnPieClientReady(UWorld* World)
+	{
+		FOtelSpan ClientSpan;
+		if (PendingPieClients.RemoveAndCopyValue(World, ClientSpan))
+		{
+			ClientSpan.End();
+			if (PendingPieClients.IsEmpty())
 			{
-				if (Context.WorldType == EWorldType::PIE)
-				{
-					// We measure the total time to start PIE by the client since it has more
-					// asset loading and streaming to do, as well as player control state updates
-					UWorld* World = Context.World();
-					if (World->GetNetMode() == NM_DedicatedServer)
-					{
-						bDidFindServerWorld = true;
-					}
-					else
-					{
-						ClientWorlds.Add(World);
-					}
-				}
+				FinishLaunchPie();
 			}
 		}
+	}
 
-		int32 ControllersPlayingCount = 0;
-		for (UWorld* World : ClientWorlds)
+	static bool IsPieClientPlaying(UWorld* World)
+	{
+		for (auto Iter = World->GetPlayerControllerIterator(); Iter; ++Iter)
 		{
-			for (auto Iter = World->GetPlayerControllerIterator(); Iter; ++Iter)
+			if (APlayerController* PC = Iter->Get())
 			{
-				if (APlayerController* PC = Iter->Get())
+				if (PC->IsLocalController() && PC->IsInState(NAME_Playing))
 				{
-					if (PC->IsInState(NAME_Playing))
-					{
-						++ControllersPlayingCount;
-					}
+					return true;
 				}
 			}
 		}
+		return false;
+	}
+
+	void FinishLaunchPie()
+	{
+		FOtelModule& Otel = FOtelModule::Get();
+		FOtelScopedSpan ScopedSpan = Otel.Unpin(*LaunchPieSpanId);
+		FOtelSpan Span = ScopedSpan.Inner();
 
-		if (ControllersPlayingCount == ClientWorlds.Num())
+		if (LaunchPieMapName.IsEmpty() == false)
 		{
-			FOtelModule& Otel = FOtelModule::Get();
-			FOtelScopedSpan ScopedSpan = Otel.Unpin(*LaunchPieSpanId);
-			FOtelSpan Span = ScopedSpan.Inner();
+			Span.AddAttribute(FAnalyticsEventAttribute(TEXT("Map"), LaunchPieMapName));
+		}
 
-			if (ClientWorlds.Num() > 0)
+		Span.AddAttribute(FAnalyticsEventAttribute(TEXT("IsHeavyPIE"), !bLaunchPieHasServer));
+
+		ResetLaunchPie();
+	}
+
+	void ResetLaunchPie()
+	{
+		for (const TWeakObjectPtr<UGameInstance>& GameInstance : PieGameInstances)
+		{
+			if (GameInstance.IsValid())
 			{
-				if (UWorld* World = ClientWorlds[0])
-				{
-					FString MapName = ParseMapName(World);
-					Span.AddAttribute(FAnalyticsEventAttribute(TEXT("Map"), MoveTemp(MapName)));
-				}
+				GameInstance->OnPawnControllerChangedDelegates.RemoveDynamic(PieListener.Get(), &UOtelPieListener::HandlePawnControllerChanged);
 			}
+		}
+		PieGameInstances.Reset();
 
-			Span.AddAttribute(FAnalyticsEventAttribute(TEXT("IsHeavyPIE"), !bDidFindServerWorld));
-
-			GEditor->GetTimerManager()->ClearTimer(LaunchPieTimer);
-			LaunchPieSpanId.Reset();
+		// Anything still pending here never got ready
+		for (TPair<TWeakObjectPtr<UWorld>, FOtelSpan>& Pair : PendingPieClients)
+		{
+			Pair.Value.End();
 		}
+		PendingPieClients.Reset();
+
+		LaunchPieSpanId.Reset();
+		LaunchPieSpan = FOtelSpan();
+		LaunchPieMapName.Reset();
+		bLaunchPieHasServer = false;
 	}
 
 	void OnPreBeginPIE(const bool bIsSimulating)
@@ -116,7 +173,9 @@ struct FOtelEditorAnalytics
 		NumPieLaunches->Add(1ull, {});
 
 		FOtelModule& Otel = FOtelModule::Get();
-		FOtelScopedSpan ScopedSpan = OTEL_SPAN(TEXT("LaunchPie"));
+		LaunchPieStartTime = FOtelTimestamp::Now();
+		FOtelScopedSpan ScopedSpan = Otel.GetTracer().StartSpanScopedOpts(TEXT("LaunchPie"), TEXT(__FILE__), __LINE__, {}, &LaunchPieStartTime);
+		LaunchPieSpan = ScopedSpan.Inner();
 		LaunchPieSpanId = Otel.Pin(ScopedSpan);
 	}
 
@@ -124,13 +183,19 @@ struct FOtelEditorAnalytics
 	{
 		if (LaunchPieSpanId.IsSet())
 		{
+			for (TPair<TWeakObjectPtr<UWorld>, FOtelSpan>& Pair : PendingPieClients)
+			{
+				Pair.Value.AddAttribute(FAnalyticsEventAttribute(TEXT("Canceled"), true));
+				Pair.Value.End();
+			}
+			PendingPieClients.Reset();
+
 			FOtelModule& Otel = FOtelModule::Get();
 			FOtelScopedSpan ScopedSpan = Otel.Unpin(*LaunchPieSpanId);
 			FOtelSpan Span = ScopedSpan.Inner();
 			Span.AddAttribute(FAnalyticsEventAttribute(TEXT("Canceled"), true));
 
-			LaunchPieSpanId.Reset();
-			GEditor->GetTimerManager()->ClearTimer(LaunchPieTimer);
+			ResetLaunchPie();
 		}
 	}
 
@@ -142,95 +207,348 @@ struct FOtelEditorAnalytics
 
 	void OnPostPIEStarted(const bool bIsSimulating)
 	{
-		ensure(LaunchPieTimer.IsValid() == false);
+		if (LaunchPieSpanId.IsSet() == false)
+		{
+			return;
+		}
+
+		if (PieListener.IsValid() == false)
+		{
+			PieListener = TStrongObjectPtr<UOtelPieListener>(NewObject<UOtelPieListener>());
+			PieListener->OnPawnControllerChanged = [this](APawn* Pawn, AController* Controller)
+				{
+					OnPiePawnControllerChanged(Pawn, Controller);
+				};
+		}
+
+		FOtelModule& Otel = FOtelModule::Get();
+		FOtelTracer Tracer = Otel.GetTracer();
+
+		// Each client gets its own span, since clients in multi-client PIE can take very different times to get ready.
+		// We measure the total time to start PIE by the clients since they have more asset loading and streaming to
+		// do, as well as player control state updates.
+		const TIndirectArray<FWorldContext>& WorldContexts = GEngine->GetWorldContexts();
+		for (const FWorldContext& Context : WorldContexts)
+		{
+			UWorld* World = Context.World();
+			if (Context.WorldType != EWorldType::PIE || World == nullptr)
+			{
+				continue;
+			}
+
+			if (World->GetNetMode() == NM_DedicatedServer)
+			{
+				bLaunchPieHasServer = true;
+				continue;
+			}
+
+			if (LaunchPieMapName.IsEmpty())
+			{
+				LaunchPieMapName = ParseMapName(World);
+			}
+
+			// Simulating has no player controllers to wait for
+			if (bIsSimulating)
+			{
+				continue;
+			}
+
+			const FAnalyticsEventAttribute Attributes[] = {
+				FAnalyticsEventAttribute(TEXT("Map"), LaunchPieMapName),
+				FAnalyticsEventAttribute(TEXT("PieInstance"), Context.PIEInstance)
+			};
+			PendingPieClients.Add(World, Tracer.StartSpanOpts(TEXT("LaunchPieClient"), TEXT(__FILE__), __LINE__, &LaunchPieSpan, Attributes, &LaunchPieStartTime));
+
+			if (UGameInstance* GameInstance = World->GetGameInstance())
+			{
+				GameInstance->OnPawnControllerChangedDelegates.AddUniqueDynamic(PieListener.Get(), &UOtelPieListener::HandlePawnControllerChanged);
+				PieGameInstances.Add(GameInstance);
+			}
+		}
 
-		auto TimerDelegate = FTimerDelegate::CreateRaw(this, &FOtelEditorAnalytics::LaunchPieEndedTick);
-		const float PollRate = 1.0f / 30.0f;
-		const bool bLoop = true;
-		GEditor->GetTimerManager()->SetTimer(LaunchPieTimer, TimerDelegate, PollRate, bLoop);
+		// Clients that got ready during startup won't possess anything again. Stale keys no longer hash to their world,
+		// so they have to be removed through the iterator.
+		for (TMap<TWeakObjectPtr<UWorld>, FOtelSpan>::TIterator It = PendingPieClients.CreateIterator(); It; ++It)
+		{
+			UWorld* World = It.Key().Get();
+			if (World == nullptr)
+			{
+				It.Value().AddAttribute(FAnalyticsEventAttribute(TEXT("Canceled"), true));
+				It.Value().End();
+				It.RemoveCurrent();
+			}
+			else if (IsPieClientPlaying(World))
+			{
+				It.Value().End();
+				It.RemoveCurrent();
+			}
+		}
+
+		if (PendingPieClients.IsEmpty())
+		{
+			FinishLaunchPie();
+		}
 	}
 
 	// Map load time hooks
 
-	void MapLoadedTick()
+	// Runs at most once per frame, and only on frames where something finished loading
+	void RequestMapLoadCheck()
 	{
-		check(MapLoadSpanId.IsSet());
+		if (bMapLoadCheckQueued == false)
+		{
+			bMapLoadCheckQueued = true;
+			GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateRaw(this, &FOtelEditorAnalytics::CheckMapLoadComplete));
+		}
+	}
 
-		UWorld* LoadedWorld = nullptr;
+	// Restarted whenever the map load makes progress
+	void RestartMapLoadTimeout()
+	{
+		GEditor->GetTimerManager()->SetTimer(MapLoadTimeoutHandle, FTimerDelegate::CreateRaw(this, &FOtelEditorAnalytics::OnMapLoadTimeout), MapLoadTimeoutSeconds, false);
+	}
 
-		const TIndirectArray<FWorldContext>& WorldContexts = GEngine->GetWorldContexts();
-		for (const FWorldContext& WorldContext : WorldContexts)
+	void OnMapLoadTimeout()
+	{
+		if (MapLoadSpanId.IsSet() == false)
+		{
+			return;
+		}
+
+		// Destroyed level instances are only noticed by a check, which may finish the load on its own
+		CheckMapLoadComplete();
+		if (MapLoadSpanId.IsSet())
+		{
+			const FAnalyticsEventAttribute Attributes[] = {
+				FAnalyticsEventAttribute(TEXT("TimedOut"), true),
+				FAnalyticsEventAttribute(TEXT("PendingLevelInstances"), PendingLevelInstances.Num()),
+				FAnalyticsEventAttribute(TEXT("PendingStreamingLevels"), PendingStreamingLevels.Num())
+			};
+			MapLoadSpan.AddAttributes(Attributes);
+
+			// Nothing happened for the whole timeout, so the load really ended with the last thing that finished
+			const FOtelTimestamp EndTime = LastMapLoadEventTime;
+			FinishMapLoad(&EndTime);
+		}
+	}
+
+	void AddPendingLevelInstances(ULevel* Level, ULevelInstanceSubsystem* LISubsystem)
+	{
+		for (AActor* Actor : Level->Actors)
 		{
-			if (WorldContext.WorldType == EWorldType::Editor)
+			if (ALevelInstance* LI = Cast<ALevelInstance>(Actor))
 			{
-				UWorld* World = WorldContext.World();
-				FString WorldName = World->GetOutermost()->GetName();
-				if (WorldName == MapLoadName)
+				if (LISubsystem->IsLoaded(LI) == false)
 				{
-					LoadedWorld = World;
-					break;
+					PendingLevelInstances.Add(LI);
 				}
 			}
 		}
+	}
+
+	void CheckMapLoadComplete()
+	{
+		bMapLoadCheckQueued = false;
+		if (MapLoadSpanId.IsSet() == false)
+		{
+			return;
+		}
 
-		bool bIsLoadComplete = false;
-		if (LoadedWorld)
+		UWorld* LoadedWorld = MapLoadWorld.Get();
+		if (bMapLoadScanned == false)
 		{
-			if (ULevelInstanceSubsystem* LISubsystem = LoadedWorld->GetSubsystem<ULevelInstanceSubsystem>())
+			const TIndirectArray<FWorldContext>& WorldContexts = GEngine->GetWorldContexts();
+			for (const FWorldContext& WorldContext : WorldContexts)
 			{
-				bool bAllLoaded = true;
-				for (TActorIterator<ALevelInstance> It(LoadedWorld); It; ++It)
+				if (WorldContext.WorldType == EWorldType::Editor)
 				{
-					if (ALevelInstance* LI = *It)
+					UWorld* World = WorldContext.World();
+					FString WorldName = World->GetOutermost()->GetName();
+					if (WorldName == MapLoadName)
 					{
-						if (LISubsystem->IsLoaded(*It) == false)
-						{
-							bAllLoaded = false;
-							break;
-						}
+						LoadedWorld = World;
+						break;
 					}
 				}
-
-				bIsLoadComplete = bAllLoaded;
 			}
 		}
-		else
+
+		if (LoadedWorld == nullptr)
 		{
 			// somehow the map load was canceled, just finish it off
-			bIsLoadComplete = true;
+			FinishMapLoad();
+			return;
 		}
 
-		if (bIsLoadComplete)
+		ULevelInstanceSubsystem* LISubsystem = LoadedWorld->GetSubsystem<ULevelInstanceSubsystem>();
+
+		// Only the first check walks every level. Level instances in levels added after that are picked up as each
+		// level is added.
+		if (bMapLoadScanned == false)
 		{
-			GEditor->GetTimerManager()->ClearTimer(MapLoadTimer);
+			bMapLoadScanned = true;
+			MapLoadWorld = LoadedWorld;
 
-			FOtelModule& Otel = FOtelModule::Get();
-			Otel.Unpin(*MapLoadSpanId);
+			// The persistent level and anything loaded with it are done by now, so level instances loading on later ticks
+			// are timed from here
+			LastMapLoadEventTime = FOtelTimestamp::Now();
+			if (LISubsystem)
+			{
+				for (ULevel* Level : LoadedWorld->GetLevels())
+				{
+					AddPendingLevelInstances(Level, LISubsystem);
+				}
+			}
+		}
 
-			if (bShouldSendInitialEditorStartSpan)
+		for (auto It = PendingLevelInstances.CreateIterator(); It; ++It)
+		{
+			ALevelInstance* LI = It->Get();
+			if (LI == nullptr || LISubsystem == nullptr || LISubsystem->IsLoaded(LI))
 			{
-				bShouldSendInitialEditorStartSpan = false;
+				It.RemoveCurrent();
+			}
+		}
 
-				const double UptimeSeconds = BVPlatformTime::ProcessUptimeSeconds();
-				if (UptimeSeconds > 0.0)
-				{
-					const int64 UptimeNanoseconds = static_cast<int64>(UptimeSeconds * 1e9);
+		if (PendingLevelInstances.IsEmpty() && PendingStreamingLevels.IsEmpty())
+		{
+			FinishMapLoad();
+		}
+	}
 
-					FOtelTimestamp Timestamp = FOtelTimestamp::Now();
-					Timestamp.System -= UptimeNanoseconds;
-					Timestamp.Steady -= UptimeNanoseconds;
+	void FinishMapLoad(const FOtelTimestamp* OptionalEndTime = nullptr)
+	{
+		FOtelModule& Otel = FOtelModule::Get();
+		{
+			// Ending the inner span first sets its end time. Releasing the scope afterwards still pops it, and ending
+			// an already ended span does nothing.
+			FOtelScopedSpan ScopedSpan = Otel.Unpin(*MapLoadSpanId);
+			if (OptionalEndTime)
+			{
+				ScopedSpan.Inner().End(OptionalEndTime);
+			}
+		}
+		ResetMapLoad();
 
-					FOtelSpan LaunchSpan = Otel.GetTracer().StartSpanOpts(TEXT("LaunchEditor"), TEXT(__FILE__), __LINE__, nullptr, {}, &Timestamp);
-				}
+		if (bShouldSendInitialEditorStartSpan && FirstMapLoadEndTime.IsSet() == false)
+		{
+			FirstMapLoadStartTime = MapLoadStartTime;
+			FirstMapLoadEndTime = OptionalEndTime ? *OptionalEndTime : FOtelTimestamp::Now();
+			FirstMapName = MapLoadName;
+			TrySendStartupTimeline();
+		}
+	}
+
+	void ResetMapLoad()
+	{
+		MapLoadSpanId.Reset();
+		MapLoadSpan = FOtelSpan();
+		MapLoadWorld.Reset();
+		if (GEditor)
+		{
+			GEditor->GetTimerManager()->ClearTimer(MapLoadTimeoutHandle);
+		}
+		PendingLevelInstances.Reset();
+		PendingStreamingLevels.Reset();
+		bMapLoadScanned = false;
+	}
+
+	bool IsMapLoadWorld(UWorld* World) const
+	{
+		return MapLoadSpanId.IsSet() && World && World->WorldType == EWorldType::Editor && World->GetOutermost()->GetName() == MapLoadName;
+	}
+
+	void OnLevelStreamingStateChanged(UWorld* World, const ULevelStreaming* StreamingLevel, ULevel* LevelIfLoaded, ELevelStreamingState PreviousState, ELevelStreamingState NewState)
+	{
+		if (IsMapLoadWorld(World) == false)
+		{
+			return;
+		}
+
+		if (NewState == ELevelStreamingState::Loading)
+		{
+			PendingStreamingLevels.Add(StreamingLevel, FOtelTimestamp::Now());
+			RestartMapLoadTimeout();
+		}
+		else if (NewState == ELevelStreamingState::FailedToLoad || NewState == ELevelStreamingState::Unloaded || NewState == ELevelStreamingState::Removed)
+		{
+			if (PendingStreamingLevels.Remove(StreamingLevel) > 0)
+			{
+				RequestMapLoadCheck();
+			}
+		}
+	}
+
+	// Each level added to the world while the map is loading gets a child span of LoadMap
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+	{
+		if (Level == nullptr || IsMapLoadWorld(World) == false)
+		{
+			return;
+		}
+
+		const TCHAR* Kind = TEXT("StreamingLevel");
+		FString LevelName = Level->GetOutermost()->GetName();
+
+		// Levels that went through streaming know when they started loading. Editor level instances are loaded one
+		// after another on the game thread, so without that each one is timed from the previous load event.
+		FOtelTimestamp StartTime = LastMapLoadEventTime;
+		if (const ULevelStreaming* StreamingLevel = FLevelUtils::FindStreamingLevel(Level))
+		{
+			PendingStreamingLevels.RemoveAndCopyValue(StreamingLevel, StartTime);
+			LevelName = StreamingLevel->GetWorldAssetPackageName();
+			if (StreamingLevel->IsA<UWorldPartitionLevelStreamingDynamic>())
+			{
+				Kind = TEXT("WorldPartitionCell");
+			}
+		}
+
+		if (ULevelInstanceSubsystem* LISubsystem = World->GetSubsystem<ULevelInstanceSubsystem>())
+		{
+			if (ILevelInstanceInterface* LevelInstance = LISubsystem->GetOwningLevelInstance(Level))
+			{
+				Kind = TEXT("LevelInstance");
+				LevelName = LevelInstance->GetWorldAssetPackage();
 			}
+
+			if (bMapLoadScanned)
+			{
+				AddPendingLevelInstances(Level, LISubsystem);
+			}
+		}
+
+		const FAnalyticsEventAttribute Attributes[] = {
+			FAnalyticsEventAttribute(TEXT("Level"), LevelName),
+			FAnalyticsEventAttribute(TEXT("Kind"), Kind)
+		};
+
+		FOtelModule& Otel = FOtelModule::Get();
+		FOtelSpan LevelSpan = Otel.GetTracer().StartSpanOpts(TEXT("LoadLevel"), TEXT(__FILE__), __LINE__, &MapLoadSpan, Attributes, &StartTime);
+
+		LastMapLoadEventTime = FOtelTimestamp::Now();
+		RestartMapLoadTimeout();
+		RequestMapLoadCheck();
+	}
+
+	// Level instances that are unloaded or whose level is removed while the map loads never get added, so whatever was
+	// waiting on them is checked again
+	void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+	{
+		if (IsMapLoadWorld(World))
+		{
+			RequestMapLoadCheck();
 		}
 	}
 
 	void OnMapLoad(const FString& Filename, FCanLoadMap& OutCanLoadMap)
 	{
-		if (MapLoadTimer.IsValid())
+		// A previous load that never completed is superseded by this one
+		if (MapLoadSpanId.IsSet())
 		{
-			GEditor->GetTimerManager()->ClearTimer(MapLoadTimer);
+			FOtelModule& Otel = FOtelModule::Get();
+			FOtelScopedSpan ScopedSpan = Otel.Unpin(*MapLoadSpanId);
+			ScopedSpan.Inner().AddAttribute(FAnalyticsEventAttribute(TEXT("Canceled"), true));
+			ResetMapLoad();
 		}
 
 		// FEditorFileUtils::LoadMap() executes this delegate, but can then return if there's any
@@ -251,20 +569,134 @@ struct FOtelEditorAnalytics
 
 		FOtelModule& Otel = FOtelModule::Get();
 		FOtelScopedSpan ScopedSpan = Otel.GetTracer().StartSpanScopedOpts(TEXT("LoadMap"), TEXT(__FILE__), __LINE__, Attributes, &MapLoadStartTime);
+		MapLoadSpan = ScopedSpan.Inner();
 		MapLoadSpanId = Otel.Pin(ScopedSpan);
+		LastMapLoadEventTime = FOtelTimestamp::Now();
+
+		// Level instances are requested while the map opens, but load on later ticks
+		RestartMapLoadTimeout();
+		RequestMapLoadCheck();
+	}
 
-		ensure(MapLoadTimer.IsValid() == false);
+	// Editor startup timeline hooks
 
-		auto TimerDelegate = FTimerDelegate::CreateRaw(this, &FOtelEditorAnalytics::MapLoadedTick);
-		const float PollRate = 1.0f / 30.0f;
-		const bool bLoop = true;
-		GEditor->GetTimerManager()->SetTimer(MapLoadTimer, TimerDelegate, PollRate, bLoop);
+	void OnLoadingPhaseComplete(ELoadingPhase::Type LoadingPhase, bool bSuccess)
+	{
+		LoadingPhaseTimes.Add({ LoadingPhase, FOtelTimestamp::Now() });
+	}
+
+	void OnPostEngineInit()
+	{
+		EngineInitTime = FOtelTimestamp::Now();
+		TrySendStartupTimeline();
+	}
+
+	void OnAssetRegistryFilesLoaded()
+	{
+		AssetScanTime = FOtelTimestamp::Now();
+		TrySendStartupTimeline();
+	}
+
+	static void AddStartupSpan(FOtelTracer& Tracer, const TCHAR* SpanName, const FOtelSpan& Parent, FOtelTimestamp StartTime, const FOtelTimestamp& EndTime, TArrayView<const FAnalyticsEventAttribute> Attributes = {})
+	{
+		FOtelSpan Span = Tracer.StartSpanOpts(SpanName, TEXT(__FILE__), __LINE__, &Parent, Attributes, &StartTime);
+		Span.End(&EndTime);
+	}
+
+	// The root of the startup timeline. It's started as soon as this module loads, so the module loading phases the
+	// runtime module traces can be parented to it as they complete.
+	void StartLaunchSpan()
+	{
+		// If the process start time isn't known, the timeline still goes out, starting from when this module loaded
+		ProcessStartTime = ModuleStartupTime;
+		const double UptimeSeconds = BVPlatformTime::ProcessUptimeSeconds();
+		if (UptimeSeconds > 0.0)
+		{
+			const int64 UptimeNanoseconds = static_cast<int64>(UptimeSeconds * 1e9);
+			ProcessStartTime = FOtelTimestamp::Now();
+			ProcessStartTime.System -= UptimeNanoseconds;
+			ProcessStartTime.Steady -= UptimeNanoseconds;
+		}
+
+		FOtelModule& Otel = FOtelModule::Get();
+		LaunchSpan = Otel.GetTracer().StartSpanOpts(TEXT("LaunchEditor"), TEXT(__FILE__), __LINE__, nullptr, {}, &ProcessStartTime);
+		bLaunchSpanStarted = true;
+		Otel.SetStartupSpan(LaunchSpan);
+	}
+
+	// Sent once engine init, the asset registry scan and the first map load have all finished, in whichever order.
+	// Phases from before this module loaded at PreDefault are only covered by EnginePreInit.
+	void TrySendStartupTimeline()
+	{
+		if (bShouldSendInitialEditorStartSpan == false || EngineInitTime.IsSet() == false || AssetScanTime.IsSet() == false || FirstMapLoadEndTime.IsSet() == false)
+		{
+			return;
+		}
+		bShouldSendInitialEditorStartSpan = false;
+
+		// Commandlets don't start the timeline up front, since they rarely get this far
+		if (bLaunchSpanStarted == false)
+		{
+			StartLaunchSpan();
+		}
+
+		FOtelModule& Otel = FOtelModule::Get();
+		FOtelTracer Tracer = Otel.GetTracer();
+
+		// Pre-init ends with the last loading phase before the engine is initialized
+		FOtelTimestamp PreInitEndTime = ModuleStartupTime;
+		for (const TPair<ELoadingPhase::Type, FOtelTimestamp>& Phase : LoadingPhaseTimes)
+		{
+			if (Phase.Value.Steady <= EngineInitTime->Steady)
+			{
+				PreInitEndTime = Phase.Value;
+			}
+		}
+
+		// The loading phases themselves are traced by the runtime module, as ModuleLoadingPhase spans under LaunchEditor
+		AddStartupSpan(Tracer, TEXT("EnginePreInit"), LaunchSpan, ProcessStartTime, PreInitEndTime);
+		AddStartupSpan(Tracer, TEXT("EngineInit"), LaunchSpan, PreInitEndTime, *EngineInitTime);
+		// The asset registry doesn't say when its scan started, only that it finished, so this is the time spent waiting
+		// for it after this module loaded
+		AddStartupSpan(Tracer, TEXT("AssetRegistryScanWait"), LaunchSpan, ModuleStartupTime, *AssetScanTime);
+
+		const FAnalyticsEventAttribute MapAttributes[] = { FAnalyticsEventAttribute(TEXT("Map"), FirstMapName) };
+		AddStartupSpan(Tracer, TEXT("FirstMapLoad"), LaunchSpan, *FirstMapLoadStartTime, *FirstMapLoadEndTime, MapAttributes);
+
+		FinishLaunchSpan();
+	}
+
+	void FinishLaunchSpan()
+	{
+		LaunchSpan.End();
+		LaunchSpan = FOtelSpan();
+		bLaunchSpanStarted = false;
+		FOtelModule::Get().SetStartupSpan(FOtelSpan());
 	}
 
 	// Startup/shutdown
 
 	void OnModuleStartup()
 	{
+		ModuleStartupTime = FOtelTimestamp::Now();
+		if (IsRunningCommandlet() == false)
+		{
+			StartLaunchSpan();
+		}
+
+		IPluginManager::Get().OnLoadingPhaseComplete().AddRaw(this, &FOtelEditorAnalytics::OnLoadingPhaseComplete);
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FOtelEditorAnalytics::OnPostEngineInit);
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		if (AssetRegistry.IsLoadingAssets())
+		{
+			AssetRegistry.OnFilesLoaded().AddRaw(this, &FOtelEditorAnalytics::OnAssetRegistryFilesLoaded);
+		}
+		else
+		{
+			AssetScanTime = ModuleStartupTime;
+		}
+
 		FEditorDelegates::PreBeginPIE.AddRaw(this, &FOtelEditorAnalytics::OnPreBeginPIE);
 		FEditorDelegates::PostPIEStarted.AddRaw(this, &FOtelEditorAnalytics::OnPostPIEStarted);
 		FEditorDelegates::CancelPIE.AddRaw(this, &FOtelEditorAnalytics::OnCancelPIE);
@@ -272,10 +704,20 @@ struct FOtelEditorAnalytics
 
 		FEditorDelegates::OnMapLoad.AddRaw(this, &FOtelEditorAnalytics::OnMapLoad);
 		FEditorDelegates::OnMapOpened.AddRaw(this, &FOtelEditorAnalytics::OnMapOpened);
+		FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FOtelEditorAnalytics::OnLevelAddedToWorld);
+		FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FOtelEditorAnalytics::OnLevelRemovedFromWorld);
+		FLevelStreamingDelegates::OnLevelStreamingStateChanged.AddRaw(this, &FOtelEditorAnalytics::OnLevelStreamingStateChanged);
 	}
 
 	void OnModuleShutdown()
 	{
+		IPluginManager::Get().OnLoadingPhaseComplete().RemoveAll(this);
+		FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+		if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+		{
+			AssetRegistryModule->Get().OnFilesLoaded().RemoveAll(this);
+		}
+
 		FEditorDelegates::PreBeginPIE.RemoveAll(this);
 		FEditorDelegates::CancelPIE.RemoveAll(this);
 		FEditorDelegates::PostPIEStarted.RemoveAll(this);
@@ -283,6 +725,23 @@ struct FOtelEditorAnalytics
 
 		FEditorDelegates::OnMapLoad.RemoveAll(this);
 		FEditorDelegates::OnMapOpened.RemoveAll(this);
+		FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+		FWorldDelegates::LevelRemovedFromWorld.RemoveAll(this);
+		FLevelStreamingDelegates::OnLevelStreamingStateChanged.RemoveAll(this);
+		if (GEditor)
+		{
+			GEditor->GetTimerManager()->ClearTimer(MapLoadTimeoutHandle);
+		}
+
+		ResetLaunchPie();
+		PieListener.Reset();
+
+		// An editor closed before it finished starting up never sends its timeline
+		if (bLaunchSpanStarted)
+		{
+			LaunchSpan.AddAttribute(FAnalyticsEventAttribute(TEXT("Incomplete"), true));
+			FinishLaunchSpan();
+		}
 	}
 };
 
@@ -297,15 +756,48 @@ class FOtelEditorModule final : public IModuleInterface, private FNoncopyable
 	virtual void ShutdownModule() override;
 
 	FOtelEditorAnalytics EditorAnalytics;
+	FOtelDdcStats* DdcStats = nullptr;
+	FOtelShaderStats* ShaderStats = nullptr;
+	FOtelCookStats* CookStats = nullptr;
+	FOtelAssetStats* AssetStats = nullptr;
+	FOtelEditorFrameStats* FrameStats = nullptr;
 };
 
 void FOtelEditorModule::StartupModule()
 {
 	EditorAnalytics.OnModuleStartup();
+	DdcStats = new FOtelDdcStats(FOtelModule::Get());
+	ShaderStats = new FOtelShaderStats(FOtelModule::Get());
+
+	if (IsRunningCookCommandlet())
+	{
+		CookStats = new FOtelCookStats(FOtelModule::Get());
+	}
+
+	if (FOtelModule::Get().GetConfig().Stats.EditorAssetSpanThresholdMs > 0)
+	{
+		AssetStats = new FOtelAssetStats(FOtelModule::Get());
+	}
+
+	if (IsRunningCommandlet() == false)
+	{
+		FrameStats = new FOtelEditorFrameStats(FOtelModule::Get());
+	}
 }
 
 void FOtelEditorModule::ShutdownModule()
 {
+	delete FrameStats;
+	FrameStats = nullptr;
+	delete AssetStats;
+	AssetStats = nullptr;
+	delete CookStats;
+	CookStats = nullptr;
+	delete ShaderStats;
+	ShaderStats = nullptr;
+	delete DdcStats;
+	DdcStats = nullptr;
+
 	EditorAnalytics.OnModuleShutdown();
 }
 
@@ -0,0 +1,11 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelPieListener.h"
+
+void UOtelPieListener::HandlePawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	if (OnPawnControllerChanged)
+	{
+		OnPawnControllerChanged(Pawn, Controller);
+	}
+}
@@ -0,0 +1,24 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "OtelPieListener.generated.h"
+
+class AController;
+class APawn;
+
+// Forwards UGameInstance::OnPawnControllerChangedDelegates to native code, since dynamic delegates can only be bound
+// to a UFUNCTION
+UCLASS(Transient)
+class UOtelPieListener : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	TFunction<void(APawn*, AController*)> OnPawnControllerChanged;
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* Controller);
+};
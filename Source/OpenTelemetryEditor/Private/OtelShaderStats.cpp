@@ -0,0 +1,154 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#include "OtelShaderStats.h"
+
+#include "ProfilingDebugging/CookStats.h"
+#include "ShaderCompiler.h"
+
+// Batches at least this long get a span. Shorter ones, like recompiling a single material, only go to the histogram.
+static const double BatchSpanThresholdSeconds = 1.0;
+
+static double ReadShaderBlockingSeconds()
+{
+	double Seconds = 0.0;
+#if ENABLE_COOK_STATS
+	FCookStatsManager::LogCookStats([&Seconds](const FString& StatName, const TArray<FCookStatsManager::StringKeyValue>& StatAttributes)
+		{
+			if (StatName != TEXT("ShaderCompiler"))
+			{
+				return;
+			}
+
+			for (const FCookStatsManager::StringKeyValue& Attribute : StatAttributes)
+			{
+				if (Attribute.Key == TEXT("BlockingTimeSec"))
+				{
+					LexFromString(Seconds, *Attribute.Value);
+				}
+			}
+		});
+#endif
+	return Seconds;
+}
+
+FOtelShaderBlockingStats::FOtelShaderBlockingStats(FOtelModule& InModule)
+	: Module(InModule)
+{
+	FOtelMeter Meter = Module.GetMeter(TEXT("editor_stats"));
+	CounterBlockingTimeMs = Meter.CreateCounter(EOtelInstrumentType::Double, TEXT("editor_stats_shader_blocking_time"), EUnit::Milliseconds);
+
+	BlockingSeconds = ReadShaderBlockingSeconds();
+
+	Module.RegisterCollector(this);
+}
+
+FOtelShaderBlockingStats::~FOtelShaderBlockingStats()
+{
+	Module.UnregisterCollector(this);
+}
+
+FName FOtelShaderBlockingStats::GetName() const
+{
+	return TEXT("ShaderBlockingStats");
+}
+
+FOtelCollectorSettings FOtelShaderBlockingStats::GetDefaultSettings() const
+{
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 5.0;
+	Settings.Thread = EOtelCollectorThread::AnyThread;
+	return Settings;
+}
+
+void FOtelShaderBlockingStats::Collect(double DeltaSeconds)
+{
+	const double NewBlockingSeconds = ReadShaderBlockingSeconds();
+
+	if (NewBlockingSeconds > BlockingSeconds)
+	{
+		CounterBlockingTimeMs->Add((NewBlockingSeconds - BlockingSeconds) * 1000.0, {});
+	}
+	BlockingSeconds = NewBlockingSeconds;
+}
+
+FOtelShaderStats::FOtelShaderStats(FOtelModule& InModule)
+	: Module(InModule)
+	, BlockingStats(InModule)
+{
+	FOtelMeter Meter = Module.GetMeter(TEXT("editor_stats"));
+
+	const uint64 QueueDepthBucketsRaw[] = { 1, 10, 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+	const FOtelHistogramBuckets QueueDepthBuckets = FOtelHistogramBuckets::From(QueueDepthBucketsRaw);
+	HistogramQueueDepth = Meter.CreateHistogram(EOtelInstrumentType::Int64, TEXT("editor_stats_shader_queue_depth"), QueueDepthBuckets);
+
+	const double BatchTimeBucketsRaw[] = { 100, 500, 1000, 5000, 10000, 30000, 60000, 120000, 300000, 600000 };
+	const FOtelHistogramBuckets BatchTimeBuckets = FOtelHistogramBuckets::From(BatchTimeBucketsRaw);
+	HistogramBatchTimeMs = Meter.CreateHistogram(EOtelInstrumentType::Double, TEXT("editor_stats_shader_batch_time"), BatchTimeBuckets, EUnit::Milliseconds);
+
+	GaugeWorkers = Meter.CreateGauge(EOtelInstrumentType::Int64, TEXT("editor_stats_shader_workers"));
+
+	Module.RegisterCollector(this);
+}
+
+FOtelShaderStats::~FOtelShaderStats()
+{
+	Module.UnregisterCollector(this);
+}
+
+FName FOtelShaderStats::GetName() const
+{
+	return TEXT("ShaderStats");
+}
+
+FOtelCollectorSettings FOtelShaderStats::GetDefaultSettings() const
+{
+	// The shader compiling manager is only safe to query from the game thread
+	FOtelCollectorSettings Settings;
+	Settings.IntervalSeconds = 0.25;
+	Settings.Thread = EOtelCollectorThread::GameThread;
+	return Settings;
+}
+
+void FOtelShaderStats::Collect(double DeltaSeconds)
+{
+	if (GShaderCompilingManager == nullptr)
+	{
+		return;
+	}
+
+	const int32 QueueDepth = GShaderCompilingManager->GetNumRemainingJobs();
+	const int32 NumWorkers = GShaderCompilingManager->GetNumLocalWorkers();
+
+	GaugeWorkers->Observe(static_cast<int64>(NumWorkers), {});
+
+	if (QueueDepth > 0)
+	{
+		HistogramQueueDepth->Record(static_cast<uint64>(QueueDepth), {});
+
+		if (bInBatch == false)
+		{
+			bInBatch = true;
+			BatchStartTime = FOtelTimestamp::Now();
+			BatchStartSeconds = FPlatformTime::Seconds();
+			BatchPeakQueueDepth = 0;
+		}
+		BatchPeakQueueDepth = FMath::Max(BatchPeakQueueDepth, QueueDepth);
+	}
+	else if (bInBatch)
+	{
+		bInBatch = false;
+
+		const double BatchSeconds = FPlatformTime::Seconds() - BatchStartSeconds;
+		HistogramBatchTimeMs->Record(BatchSeconds * 1000.0, {});
+
+		if (BatchSeconds >= BatchSpanThresholdSeconds)
+		{
+			const FAnalyticsEventAttribute Attributes[] = {
+				FAnalyticsEventAttribute(TEXT("PeakQueueDepth"), BatchPeakQueueDepth),
+				FAnalyticsEventAttribute(TEXT("Workers"), NumWorkers)
+			};
+
+			FOtelSpan BatchSpan = Module.GetTracer().StartSpanOpts(TEXT("CompileShaders"), TEXT(__FILE__), __LINE__, nullptr, Attributes, &BatchStartTime);
+		}
+	}
+}
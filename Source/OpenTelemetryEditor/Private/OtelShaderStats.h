@@ -0,0 +1,54 @@
+// Copyright The Believer Company. All Rights Reserved.
+
+#pragma once
+
+#include "Otel.h"
+
+// Reports the time the editor spent blocked waiting on shaders. The shader compiler only keeps it in its cook stats,
+// and reading those runs every registered cook stats callback, so it's read off the game thread on a slow cadence.
+class FOtelShaderBlockingStats : public IOtelCollector
+{
+public:
+	FOtelShaderBlockingStats(FOtelModule& InModule);
+	~FOtelShaderBlockingStats();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	FOtelModule& Module;
+
+	double BlockingSeconds = 0.0;
+
+	TSharedPtr<FOtelCounter> CounterBlockingTimeMs;
+};
+
+// Samples the shader compiling manager's queue and worker count, and times shader compile batches: each stretch of
+// time from when jobs are queued until the queue drains. Batches get a histogram sample, and a CompileShaders span if
+// they're long enough to be noticed.
+class FOtelShaderStats : public IOtelCollector
+{
+public:
+	FOtelShaderStats(FOtelModule& InModule);
+	~FOtelShaderStats();
+
+	// IOtelCollector
+	virtual FName GetName() const override;
+	virtual FOtelCollectorSettings GetDefaultSettings() const override;
+	virtual void Collect(double DeltaSeconds) override;
+
+private:
+	FOtelModule& Module;
+	FOtelShaderBlockingStats BlockingStats;
+
+	bool bInBatch = false;
+	FOtelTimestamp BatchStartTime;
+	double BatchStartSeconds = 0.0;
+	int32 BatchPeakQueueDepth = 0;
+
+	TSharedPtr<FOtelHistogram> HistogramQueueDepth;
+	TSharedPtr<FOtelHistogram> HistogramBatchTimeMs;
+	TSharedPtr<FOtelGauge> GaugeWorkers;
+};